@@ -0,0 +1,216 @@
+#include "cvrp_batch.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <set>
+#include <stdexcept>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include "cvrp_inputFile.h"
+
+namespace cvrp
+{
+
+namespace
+{
+bool hasSuffix(const std::string& name, const char *suffix)
+{
+    const size_t length = strlen(suffix);
+    return name.size() > length && name.compare(name.size() - length, length, suffix) == 0;
+}
+
+bool hasInstanceExtension(const std::string& name)
+{
+    for (const char *extension : { ".json", ".vrp", ".bin" })
+    {
+        if (hasSuffix(name, extension))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Written by an earlier batch into the directory it read from */
+bool isResultName(const std::string& name)
+{
+    for (const char *suffix : { ".solution.txt", ".solution.json", ".solution.bin" })
+    {
+        if (hasSuffix(name, suffix))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string directoryOf(const std::string& path)
+{
+    const size_t slash = path.rfind('/');
+    return slash == std::string::npos ? std::string() : path.substr(0, slash + 1);
+}
+}
+
+std::vector<std::string> Batch::listInstances(const std::string& manifestOrDirectory)
+{
+    std::vector<std::string> instances;
+    struct stat info;
+    if (stat(manifestOrDirectory.c_str(), &info) < 0)
+    {
+        throw std::runtime_error("Cannot open " + manifestOrDirectory + ": " + strerror(errno));
+    }
+    if (S_ISDIR(info.st_mode))
+    {
+        DIR *directory = opendir(manifestOrDirectory.c_str());
+        if (!directory)
+        {
+            throw std::runtime_error("Cannot read " + manifestOrDirectory + ": " + strerror(errno));
+        }
+        while (const dirent *entry = readdir(directory))
+        {
+            const std::string path = manifestOrDirectory + "/" + entry->d_name;
+            if (hasInstanceExtension(entry->d_name) && !isResultName(entry->d_name)
+                    && stat(path.c_str(), &info) == 0 && S_ISREG(info.st_mode))
+            {
+                instances.push_back(path);
+            }
+        }
+        closedir(directory);
+        std::sort(instances.begin(), instances.end());
+        return instances;
+    }
+
+    /* A manifest: one path per line, relative ones from the manifest's directory, # comments */
+    std::shared_ptr<const InputFile> manifest = InputFile::open(manifestOrDirectory);
+    const std::string base = directoryOf(manifestOrDirectory);
+    std::string_view text = manifest->text();
+    while (!text.empty())
+    {
+        const size_t end = std::min(text.find('\n'), text.size());
+        std::string_view line = text.substr(0, end);
+        text.remove_prefix(std::min(end + 1, text.size()));
+        while (!line.empty() && (line.front() == ' ' || line.front() == '\t'))
+        {
+            line.remove_prefix(1);
+        }
+        while (!line.empty() && (line.back() == ' ' || line.back() == '\t' || line.back() == '\r'))
+        {
+            line.remove_suffix(1);
+        }
+        if (line.empty() || line.front() == '#')
+        {
+            continue;
+        }
+        instances.push_back(line.front() == '/' ? std::string(line) : base + std::string(line));
+    }
+    return instances;
+}
+
+std::string Batch::resultPath(const std::string& instance, const BatchOptions& options)
+{
+    const std::string name = instance.substr(instance.rfind('/') + 1);
+    return options.outputDirectory + "/" + name + ".solution." + SolutionWriter::extension(options.format);
+}
+
+void Batch::solveOne(const std::string& instance, const BatchOptions& options)
+{
+    std::unique_ptr<DataModel> model = DataModel::load(InputFile::open(instance), options.model);
+    SolutionFinder finder(*model, options.routes);
+    const SolutionModel solution = finder.solutionWithEvolution(options.evolution);
+
+    const std::string path = resultPath(instance, options);
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        throw std::runtime_error("Cannot create " + path + ": " + strerror(errno));
+    }
+    try
+    {
+        SolutionWriter::write(fd, solution, options.format);
+    }
+    catch (...)
+    {
+        ::close(fd);
+        throw;
+    }
+    ::close(fd);
+}
+
+BatchResult Batch::run(const std::vector<std::string>& instances, const BatchOptions& options)
+{
+    std::atomic<size_t> solved(0);
+    std::atomic<size_t> failed(0);
+    const auto start = std::chrono::steady_clock::now();
+
+    /* Two instances with the same file name would write one result, and a result must never replace an input */
+    std::vector<std::string> clash(instances.size());
+    std::set<std::string> taken;
+    std::set<std::pair<dev_t, ino_t>> inputs;
+    for (const auto& instance : instances)
+    {
+        struct stat info;
+        if (stat(instance.c_str(), &info) == 0)
+        {
+            inputs.insert(std::make_pair(info.st_dev, info.st_ino));
+        }
+    }
+    for (size_t i = 0; i < instances.size(); i++)
+    {
+        const std::string path = resultPath(instances[i], options);
+        struct stat info;
+        if (!taken.insert(path).second)
+        {
+            clash[i] = "result " + path + " is already written by another instance";
+        }
+        else if (stat(path.c_str(), &info) == 0 && inputs.count(std::make_pair(info.st_dev, info.st_ino)))
+        {
+            clash[i] = "result " + path + " would overwrite an input";
+        }
+    }
+
+#ifdef _OPENMP
+    /* One instance per thread; nested regions inside the solver then run on their own thread */
+    const int levels = omp_get_max_active_levels();
+    omp_set_max_active_levels(1);
+#endif
+
+#pragma omp parallel for schedule(dynamic, 1)
+    for (size_t i = 0; i < instances.size(); i++)
+    {
+        try
+        {
+            if (!clash[i].empty())
+            {
+                throw std::runtime_error(clash[i]);
+            }
+            solveOne(instances[i], options);
+            solved++;
+        }
+        catch (const std::exception& error)
+        {
+            fprintf(stderr, "%s: %s\n", instances[i].c_str(), error.what());
+            failed++;
+        }
+    }
+
+#ifdef _OPENMP
+    omp_set_max_active_levels(levels);
+#endif
+
+    BatchResult result;
+    result.solved = solved;
+    result.failed = failed;
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+}//cvrp namespace
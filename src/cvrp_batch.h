@@ -0,0 +1,50 @@
+#ifndef CVRP_BATCH
+#define CVRP_BATCH
+
+#include <string>
+#include <vector>
+#include "cvrp_dataModel.h"
+#include "cvrp_solutionFinder.h"
+#include "cvrp_solutionWriter.h"
+
+namespace cvrp
+{
+struct BatchOptions
+{
+    DataModelOptions model;
+    EvolutionOptions evolution;
+    RouteOptimiser routes = RouteOptimiser::Greedy;
+    SolutionFormat format = SolutionFormat::Text;
+    std::string outputDirectory = ".";
+};
+
+struct BatchResult
+{
+    size_t solved = 0;
+    size_t failed = 0;
+    double seconds = 0;
+};
+
+/*
+ * Solves many instances in one process.  Instances are handed out one at
+ * a time to the threads of a single OpenMP team, each solving its own
+ * instance with the inner parallel regions serialised, and every result
+ * goes to <output directory>/<instance file name>.solution.<txt|json|bin>,
+ * so a.json and a.vrp keep apart and no input is overwritten.  A failing
+ * instance, or one whose result path another instance or an input already
+ * has, is reported on stderr and does not stop the others.
+ */
+class Batch
+{
+    public:
+        /* Regular .json, .vrp and .bin files of a directory other than results, or the lines of a manifest file */
+        static std::vector<std::string> listInstances(const std::string& manifestOrDirectory);
+        static BatchResult run(const std::vector<std::string>& instances, const BatchOptions& options);
+        static std::string resultPath(const std::string& instance, const BatchOptions& options);
+
+    private:
+        static void solveOne(const std::string& instance, const BatchOptions& options);
+};
+
+}//cvrp namespace
+#endif
@@ -0,0 +1,429 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+#include <string>
+#include <sys/resource.h>
+#include "cvrp_binaryInstance.h"
+#include "cvrp_dataModel.h"
+#include "cvrp_instanceDelta.h"
+#include "cvrp_jsonReader.h"
+#include "cvrp_routeMoves.h"
+#include "cvrp_vrpReader.h"
+#include "cvrp_solutionFinder.h"
+#include "cvrp_util.h"
+#include "json/json.h"
+
+using namespace cvrp;
+
+/* Every heap allocation of the process, for the allocations benchmark */
+static std::atomic<unsigned long> allocations(0);
+
+void *operator new(size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *memory = malloc(size ? size : 1))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept
+{
+    free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept
+{
+    free(memory);
+}
+
+namespace
+{
+
+typedef std::chrono::steady_clock Clock;
+
+double secondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/* Mutations per second of SolutionFinder::make_crossover on a fixed parent */
+int benchMutations(const char *path, unsigned long count)
+{
+    DataModelOptions options;
+    if (const char *distanceStorage = getenv("DISTANCE_STORAGE"))
+    {
+        options.distanceStorage = DistanceMatrix::parseStorage(distanceStorage);
+    }
+    std::unique_ptr<DataModel> dataModel = DataModel::load(InputFile::open(path), options);
+    const DataModel& model = *dataModel;
+    SolutionFinder finder(model);
+    Util::seed_prngs();
+
+    auto genome = model.getClients();
+    std::shuffle(genome.begin(), genome.end(), Util::get_prng());
+    const SolutionModel parent = finder.getNaiveSolution(genome);
+    /* Cache the parent's totals first, as the population does */
+    parent.getCost();
+
+    double checksum = 0;
+    auto start = Clock::now();
+    for (unsigned long i = 0; i < count; i++)
+    {
+        checksum += finder.make_crossover(parent).getCost();
+    }
+    double elapsed = secondsSince(start);
+
+    printf("mutations=%lu routes=%zu elapsed=%.3fs rate=%.0f mutations/s (checksum %.1f)\n",
+            count, parent.chromosomesConst().size(), elapsed, count / elapsed, checksum);
+    return 0;
+}
+
+/* Heap allocations per make_crossover on a fixed parent */
+int benchAllocations(const char *path, unsigned long count)
+{
+    std::unique_ptr<DataModel> model = DataModel::load(InputFile::open(path));
+    SolutionFinder finder(*model);
+    Util::seed_prngs(1);
+    auto genome = model->getClients();
+    std::shuffle(genome.begin(), genome.end(), Util::get_prng());
+    const SolutionModel parent = finder.getNaiveSolution(genome);
+    size_t longest = 0;
+    for (const auto& trip : parent.chromosomesConst())
+    {
+        longest = std::max(longest, trip.getSeqSize());
+    }
+
+    double checksum = 0;
+    const unsigned long before = allocations;
+    for (unsigned long i = 0; i < count; i++)
+    {
+        checksum += finder.make_crossover(parent).getCost();
+    }
+    const unsigned long made = allocations - before;
+
+    printf("mutations=%lu routes=%zu longest_route=%zu allocations=%lu per_mutation=%.2f (checksum %.1f)\n",
+            count, parent.chromosomesConst().size(), longest, made, (double) made / count, checksum);
+    return 0;
+}
+
+/* Time from file name to a ready DataModel, in any input format */
+int benchLoad(const char *path)
+{
+    auto start = Clock::now();
+    std::shared_ptr<const InputFile> file = InputFile::open(path);
+    std::unique_ptr<DataModel> model = DataModel::load(file);
+    double elapsed = secondsSince(start);
+
+    const char *format = BinaryInstance::isBinary(*file) ? "binary" :
+        VrpReader::isVrp(file->text()) ? "vrp" : "json";
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    printf("format=%s clients=%d elapsed=%.3fs peak_rss=%.1fMiB\n", format, model->numberOfClients(), elapsed,
+            usage.ru_maxrss / 1024.0);
+    return 0;
+}
+
+/* The jsoncpp document path DataModel used before JsonReader, kept as the baseline */
+InstanceData parseWithJsoncpp(const InputFile& file)
+{
+    std::stringstream jsonStream;
+    jsonStream.write(file.data(), file.size());
+    Json::Value root;
+    jsonStream >> root;
+
+    InstanceData data;
+    data.vehicleCapacity = root.get("vehicleCapacity", -1).asInt();
+    Json::Value& clients = root["nodes"];
+    data.xs.push_back(root["depot"].get("x", -1).asInt());
+    data.ys.push_back(root["depot"].get("y", -1).asInt());
+    data.demands.push_back(0);
+    for (unsigned int i = 0; i < clients.size(); i++)
+    {
+        data.xs.push_back(clients[i].get("x", -1).asInt());
+        data.ys.push_back(clients[i].get("y", -1).asInt());
+        data.demands.push_back(clients[i].get("demand", -1).asInt());
+    }
+    return data;
+}
+
+/* Parse time alone of a JSON instance, JsonReader against the jsoncpp document */
+int benchJson(const char *path, int rounds)
+{
+    std::shared_ptr<const InputFile> file = InputFile::open(path);
+    const std::string_view text = file->text();
+    size_t checksum = 0;
+
+    auto start = Clock::now();
+    for (int i = 0; i < rounds; i++)
+    {
+        checksum += JsonReader::parse(text, path).xs.size();
+    }
+    double reader = secondsSince(start) / rounds;
+
+    start = Clock::now();
+    for (int i = 0; i < rounds; i++)
+    {
+        checksum -= parseWithJsoncpp(*file).xs.size();
+    }
+    double jsoncpp = secondsSince(start) / rounds;
+
+    printf("bytes=%zu reader=%.4fs jsoncpp=%.4fs speedup=%.1fx%s\n", file->size(), reader, jsoncpp,
+            jsoncpp / reader, checksum == 0 ? "" : " (node counts differ)");
+    return 0;
+}
+
+/* Build time of the K-nearest candidate lists over n uniformly random clients */
+int benchNeighbours(unsigned long clients, int count)
+{
+    std::mt19937 prng(42);
+    std::uniform_int_distribution<int> coord(0, 100'000);
+    AlignedVector<int> xs(clients + 1), ys(clients + 1);
+    for (unsigned long i = 0; i <= clients; i++)
+    {
+        xs[i] = coord(prng);
+        ys[i] = coord(prng);
+    }
+
+    Span<const int> xSpan(xs.data(), xs.size());
+    Span<const int> ySpan(ys.data(), ys.size());
+    SpatialGrid grid;
+    NeighbourLists lists;
+    auto start = Clock::now();
+    grid.build(xSpan, ySpan);
+    lists.build(xSpan, ySpan, count, grid);
+    double elapsed = secondsSince(start);
+
+    printf("clients=%lu neighbours=%d elapsed=%.3fs\n", clients, lists.count(), elapsed);
+    return 0;
+}
+
+/* Latency of one-client edits (an addition, a removal, a demand change) against a full re-solve */
+int benchDelta(const char *path, int rounds)
+{
+    std::unique_ptr<DataModel> model = DataModel::load(InputFile::open(path));
+    EvolutionOptions options;
+    options.initialPopulation = 1'000;
+    options.maxMutationsPerGeneration = 1'000'000;
+    options.progress = false;
+    options.seed = 1;
+    options.timeLimit = 30;
+
+    auto start = Clock::now();
+    SolutionModel solution = SolutionFinder(*model).solutionWithEvolution(options);
+    const double full = secondsSince(start);
+    const Cost initial = solution.getCost();
+
+    std::mt19937 prng(7);
+    double applying = 0;
+    double repairing = 0;
+    for (int round = 0; round < rounds; round++)
+    {
+        const int clients = model->numberOfClients();
+        InstanceDelta delta;
+        const int client = std::uniform_int_distribution<int>(1, clients)(prng);
+        switch (round % 3)
+        {
+        case 0:
+        {
+            ClientChange added;
+            added.x = model->view().x(client) + 1;
+            added.y = model->view().y(client) + 1;
+            added.demand = std::max(1, model->view().demand(client) / 2);
+            delta.added.push_back(added);
+            break;
+        }
+        case 1:
+            delta.removed.push_back(client);
+            break;
+        default:
+        {
+            ClientChange modified;
+            modified.id = client;
+            modified.x = model->view().x(client);
+            modified.y = model->view().y(client);
+            modified.demand = model->view().demand(client) + 5;
+            delta.modified.push_back(modified);
+            break;
+        }
+        }
+
+        start = Clock::now();
+        std::vector<int> newIds;
+        std::unique_ptr<DataModel> edited = delta.apply(*model, DataModelOptions(), newIds);
+        applying += secondsSince(start);
+        start = Clock::now();
+        SolutionFinder finder(*edited);
+        solution = finder.repair(solution, newIds, delta.changedClients(newIds));
+        repairing += secondsSince(start);
+        if (!finder.validateSolution(solution) || !solution.isFeasible())
+        {
+            fprintf(stderr, "Repair gave an invalid solution in round %d\n", round);
+            return 1;
+        }
+        model = std::move(edited);
+    }
+
+    printf("clients=%d rounds=%d apply=%.3fms repair=%.3fms full_solve=%.1fms cost=%.1f->%.1f\n",
+            model->numberOfClients(), rounds, applying * 1e3 / rounds, repairing * 1e3 / rounds, full * 1e3,
+            (double) initial, (double) solution.getCost());
+    return 0;
+}
+
+/*
+ * Each route optimiser's price and payoff: the mutation rate of make_crossover,
+ * then the cost an equally seeded evolution reaches within the same time
+ */
+int benchRoutes(const char *path, unsigned long count, double seconds)
+{
+    std::unique_ptr<DataModel> model = DataModel::load(InputFile::open(path));
+    for (const RouteOptimiser optimiser : { RouteOptimiser::Greedy, RouteOptimiser::TwoOpt, RouteOptimiser::LocalSearch })
+    {
+        SolutionFinder finder(*model, optimiser);
+        Util::seed_prngs(1);
+        auto genome = model->getClients();
+        std::shuffle(genome.begin(), genome.end(), Util::get_prng());
+        const SolutionModel parent = finder.getNaiveSolution(genome);
+
+        auto start = Clock::now();
+        for (unsigned long i = 0; i < count; i++)
+        {
+            finder.make_crossover(parent);
+        }
+        const double elapsed = secondsSince(start);
+
+        EvolutionOptions evolution;
+        evolution.progress = false;
+        evolution.timeLimit = seconds;
+        evolution.seed = 1;
+        const SolutionModel solution = finder.solutionWithEvolution(evolution);
+
+        printf("routes=%s naive_cost=%.1f rate=%.0f mutations/s evolved_cost=%.1f in %.1fs\n",
+                RouteSearch::name(optimiser), (double) parent.getCost(), count / elapsed,
+                (double) solution.getCost(), seconds);
+    }
+    return 0;
+}
+
+/* Random relocates between trips of a naive solution, priced in O(1) and by applying them to copies */
+int benchMoves(const char *path, unsigned long count)
+{
+    std::unique_ptr<DataModel> model = DataModel::load(InputFile::open(path));
+    SolutionFinder finder(*model);
+    Util::seed_prngs(1);
+    auto genome = model->getClients();
+    std::shuffle(genome.begin(), genome.end(), Util::get_prng());
+    SolutionModel solution = finder.getNaiveSolution(genome);
+    for (auto& trip : solution.chromosomes())
+    {
+        trip.updateSegments();
+    }
+    const auto& trips = solution.chromosomesConst();
+    if (trips.size() < 2)
+    {
+        fprintf(stderr, "The instance needs at least two trips\n");
+        return 1;
+    }
+
+    struct Move
+    {
+        size_t from, position, to, insertion;
+    };
+    std::vector<Move> moves(count);
+    auto& prng = Util::get_prng();
+    for (auto& move : moves)
+    {
+        move.from = std::uniform_int_distribution<size_t>(0, trips.size() - 1)(prng);
+        do
+        {
+            move.to = std::uniform_int_distribution<size_t>(0, trips.size() - 1)(prng);
+        } while (move.to == move.from);
+        move.position = std::uniform_int_distribution<size_t>(0, trips[move.from].getSeqSize() - 1)(prng);
+        move.insertion = std::uniform_int_distribution<size_t>(0, trips[move.to].getSeqSize())(prng);
+    }
+
+    double evaluated = 0;
+    size_t improving = 0;
+    auto start = Clock::now();
+    for (const auto& move : moves)
+    {
+        const MoveEvaluation evaluation = RouteMoves::relocate(trips[move.from], move.position, trips[move.to], move.insertion);
+        evaluated += evaluation.delta;
+        improving += evaluation.feasible && evaluation.delta < 0;
+    }
+    const double constant = secondsSince(start);
+
+    double applied = 0;
+    start = Clock::now();
+    for (const auto& move : moves)
+    {
+        VehicleTrip from = trips[move.from];
+        VehicleTrip to = trips[move.to];
+        RouteMoves::applyCrossExchange(from, move.position, 1, to, move.insertion, 0);
+        applied += from.cost() + to.cost() - trips[move.from].cost() - trips[move.to].cost();
+    }
+    const double materialised = secondsSince(start);
+
+    printf("moves=%lu routes=%zu improving=%zu evaluated=%.0f/s applied=%.0f/s speedup=%.1fx (checksums %.1f %.1f)\n",
+            count, trips.size(), improving, count / constant, count / materialised, materialised / constant,
+            evaluated, applied);
+    return 0;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "usage: %s mutations <instance> [count]\n"
+                "       %s load <instance>\n"
+                "       %s json <instance.json> [rounds]\n"
+                "       %s neighbours <clients> [K]\n"
+                "       %s delta <instance> [rounds]\n"
+                "       %s routes <instance> [mutations] [seconds]\n"
+                "       %s moves <instance> [count]\n"
+                "       %s allocations <instance> [count]\n", argv[0], argv[0], argv[0], argv[0], argv[0], argv[0], argv[0], argv[0]);
+        return 1;
+    }
+    const std::string mode = argv[1];
+    if (mode == "mutations")
+    {
+        return benchMutations(argv[2], argc > 3 ? strtoul(argv[3], nullptr, 10) : 1'000'000);
+    }
+    if (mode == "load")
+    {
+        return benchLoad(argv[2]);
+    }
+    if (mode == "json")
+    {
+        return benchJson(argv[2], argc > 3 ? atoi(argv[3]) : 5);
+    }
+    if (mode == "neighbours")
+    {
+        return benchNeighbours(strtoul(argv[2], nullptr, 10), argc > 3 ? atoi(argv[3]) : NeighbourLists::defaultCount);
+    }
+    if (mode == "delta")
+    {
+        return benchDelta(argv[2], argc > 3 ? atoi(argv[3]) : 30);
+    }
+    if (mode == "routes")
+    {
+        return benchRoutes(argv[2], argc > 3 ? strtoul(argv[3], nullptr, 10) : 100'000, argc > 4 ? atof(argv[4]) : 10);
+    }
+    if (mode == "allocations")
+    {
+        return benchAllocations(argv[2], argc > 3 ? strtoul(argv[3], nullptr, 10) : 1'000'000);
+    }
+    if (mode == "moves")
+    {
+        return benchMoves(argv[2], argc > 3 ? strtoul(argv[3], nullptr, 10) : 1'000'000);
+    }
+    fprintf(stderr, "Unknown benchmark: %s\n", argv[1]);
+    return 1;
+}
@@ -0,0 +1,206 @@
+#include "cvrp_binaryInstance.h"
+
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include "cvrp_dataModel.h"
+
+namespace cvrp
+{
+
+constexpr char BinaryInstance::magic[8];
+
+namespace
+{
+uint64_t alignUp(uint64_t offset, uint64_t alignment)
+{
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+void pad(std::ostream& out, uint64_t& offset, uint64_t alignment)
+{
+    static const char zeros[64] = {};
+    const uint64_t aligned = alignUp(offset, alignment);
+    out.write(zeros, aligned - offset);
+    offset = aligned;
+}
+
+void writeSection(std::ostream& out, uint64_t& offset, const void *data, uint64_t bytes)
+{
+    out.write(static_cast<const char *>(data), bytes);
+    offset += bytes;
+}
+}
+
+bool BinaryInstance::isBinary(const InputFile& file)
+{
+    return file.size() >= sizeof(magic) && memcmp(file.data(), magic, sizeof(magic)) == 0;
+}
+
+BinaryInstance::BinaryInstance(std::shared_ptr<const InputFile> file) :
+    m_file(std::move(file)),
+    m_header(reinterpret_cast<const Header *>(m_file->data()))
+{
+    if (m_file->size() < sizeof(Header) || !isBinary(*m_file))
+    {
+        invalid("not a binary instance");
+    }
+    if (m_header->byteOrder != byteOrderMark)
+    {
+        invalid("written with a different byte order");
+    }
+    if (m_header->version != version)
+    {
+        std::stringstream error;
+        error << "unsupported version " << m_header->version;
+        invalid(error.str());
+    }
+    if (m_header->nodes < 1 || m_header->nodes > uint64_t(INT32_MAX))
+    {
+        invalid("bad node count");
+    }
+    if (m_header->vehicleCapacity < 0)
+    {
+        std::stringstream error;
+        error << "Invalid Vehicle Capacity: " << m_header->vehicleCapacity;
+        invalid(error.str());
+    }
+    const uint64_t nodes = m_header->nodes;
+    checkSection("x coordinates", m_header->xsOffset, nodes * sizeof(int));
+    checkSection("y coordinates", m_header->ysOffset, nodes * sizeof(int));
+    checkSection("demands", m_header->demandsOffset, nodes * sizeof(int));
+    for (uint64_t i = 0; i < nodes; i++)
+    {
+        if (xs()[i] < 0 || ys()[i] < 0 || demands()[i] < 0)
+        {
+            std::stringstream error;
+            error << "invalid data for node " << i;
+            invalid(error.str());
+        }
+    }
+    if (demands()[0] != 0)
+    {
+        invalid("the depot has a demand");
+    }
+
+    if (m_header->flags & HasDistances)
+    {
+        if (distanceStorage() != DistanceStorage::Dense && distanceStorage() != DistanceStorage::Triangular)
+        {
+            invalid("bad distance storage");
+        }
+        checkSection("distances", m_header->distancesOffset, m_header->distancesBytes);
+    }
+    if (m_header->flags & HasNeighbours)
+    {
+        if (m_header->neighbourCount != NeighbourLists::effectiveCount(m_header->neighbourCount, nodes))
+        {
+            invalid("bad neighbour count");
+        }
+        checkSection("neighbour lists", m_header->neighboursOffset, nodes * m_header->neighbourCount * sizeof(int));
+        for (int id : neighbours())
+        {
+            if (id < 1 || uint64_t(id) >= nodes)
+            {
+                std::stringstream error;
+                error << "bad neighbour " << id;
+                invalid(error.str());
+            }
+        }
+    }
+}
+
+bool BinaryInstance::hasDistances() const
+{
+    if (!(m_header->flags & HasDistances))
+    {
+        return false;
+    }
+#ifdef CVRP_ROUNDED_DISTANCES
+    const bool rounded = true;
+#else
+    const bool rounded = false;
+#endif
+    return bool(m_header->flags & RoundedDistances) == rounded &&
+        m_header->distancesBytes == DistanceMatrix::rawBytes(distanceStorage(), m_header->nodes);
+}
+
+void BinaryInstance::checkSection(const char *name, uint64_t offset, uint64_t bytes) const
+{
+    if (offset % alignment != 0 || offset < sizeof(Header) || offset > m_file->size() || bytes > m_file->size() - offset)
+    {
+        invalid(std::string("bad ") + name + " section");
+    }
+}
+
+void BinaryInstance::invalid(const std::string& reason) const
+{
+    throw std::invalid_argument("Invalid binary instance " + m_file->path() + ": " + reason);
+}
+
+void BinaryInstance::write(const DataModel& model, std::ostream& out, bool distances, bool neighbours)
+{
+    const uint64_t nodes = model.clientXs().size();
+    const DistanceMatrix& matrix = model.distances();
+    distances = distances && matrix.rawData() != nullptr;
+    neighbours = neighbours && model.neighbourLists().count() > 0;
+
+    Header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, magic, sizeof(magic));
+    header.version = version;
+    header.byteOrder = byteOrderMark;
+    header.vehicleCapacity = model.vehicleCapacity();
+    header.nodes = nodes;
+#ifdef CVRP_ROUNDED_DISTANCES
+    header.flags |= RoundedDistances;
+#endif
+
+    uint64_t offset = alignUp(sizeof(Header), alignment);
+    header.xsOffset = offset;
+    offset = alignUp(offset + nodes * sizeof(int), alignment);
+    header.ysOffset = offset;
+    offset = alignUp(offset + nodes * sizeof(int), alignment);
+    header.demandsOffset = offset;
+    offset = alignUp(offset + nodes * sizeof(int), alignment);
+    if (distances)
+    {
+        header.flags |= HasDistances;
+        header.distanceStorage = static_cast<uint32_t>(matrix.storage());
+        header.distancesOffset = offset;
+        header.distancesBytes = matrix.rawBytes();
+        offset = alignUp(offset + header.distancesBytes, alignment);
+    }
+    if (neighbours)
+    {
+        header.flags |= HasNeighbours;
+        header.neighbourCount = model.neighbourLists().count();
+        header.neighboursOffset = offset;
+    }
+
+    offset = 0;
+    writeSection(out, offset, &header, sizeof(header));
+    pad(out, offset, alignment);
+    writeSection(out, offset, model.clientXs().data(), nodes * sizeof(int));
+    pad(out, offset, alignment);
+    writeSection(out, offset, model.clientYs().data(), nodes * sizeof(int));
+    pad(out, offset, alignment);
+    writeSection(out, offset, model.clientDemands().data(), nodes * sizeof(int));
+    if (distances)
+    {
+        pad(out, offset, alignment);
+        writeSection(out, offset, matrix.rawData(), header.distancesBytes);
+    }
+    if (neighbours)
+    {
+        pad(out, offset, alignment);
+        Span<const int> lists = model.neighbourLists().all();
+        writeSection(out, offset, lists.data(), lists.size() * sizeof(int));
+    }
+    if (!out)
+    {
+        throw std::runtime_error("Failed writing binary instance");
+    }
+}
+
+}//cvrp namespace
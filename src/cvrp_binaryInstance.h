@@ -0,0 +1,90 @@
+#ifndef CVRP_BINARY_INSTANCE
+#define CVRP_BINARY_INSTANCE
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include "cvrp_inputFile.h"
+#include "cvrp_distanceMatrix.h"
+#include "cvrp_util.h"
+
+namespace cvrp
+{
+class DataModel;
+
+/*
+ * Versioned binary instance, meant to be mapped and used in place.  A fixed
+ * header is followed by 64-byte aligned sections: x coordinates, y
+ * coordinates and demands as int32 (index 0 is the depot), then optionally
+ * the distance matrix exactly as DistanceMatrix lays it out, and the
+ * row-major neighbour lists.  Everything is in native byte order; files
+ * from another byte order or version are rejected by the header check.
+ */
+class BinaryInstance
+{
+    public:
+        static constexpr uint32_t version = 1;
+
+        enum Flags : uint32_t
+        {
+            HasDistances = 1,
+            HasNeighbours = 2,
+            RoundedDistances = 4   /* Matrix written by a ROUNDED=y build */
+        };
+
+        /* Validates the header, the section bounds and every array once */
+        explicit BinaryInstance(std::shared_ptr<const InputFile> file);
+
+        static bool isBinary(const InputFile& file);
+        static void write(const DataModel& model, std::ostream& out, bool distances, bool neighbours);
+
+        const std::shared_ptr<const InputFile>& file() const { return m_file; }
+        int vehicleCapacity() const { return m_header->vehicleCapacity; }
+        Span<const int> xs() const { return section<int>(m_header->xsOffset, m_header->nodes); }
+        Span<const int> ys() const { return section<int>(m_header->ysOffset, m_header->nodes); }
+        Span<const int> demands() const { return section<int>(m_header->demandsOffset, m_header->nodes); }
+
+        /* A matrix is only offered to builds that use the same distance type */
+        bool hasDistances() const;
+        DistanceStorage distanceStorage() const { return static_cast<DistanceStorage>(m_header->distanceStorage); }
+        const void *distances() const { return m_file->data() + m_header->distancesOffset; }
+
+        bool hasNeighbours() const { return m_header->flags & HasNeighbours; }
+        int neighbourCount() const { return m_header->neighbourCount; }
+        Span<const int> neighbours() const
+            { return section<int>(m_header->neighboursOffset, m_header->nodes * m_header->neighbourCount); }
+
+    private:
+        struct Header
+        {
+            char magic[8];
+            uint32_t version;
+            uint32_t byteOrder;
+            uint32_t flags;
+            int32_t vehicleCapacity;
+            uint64_t nodes;
+            int32_t neighbourCount;
+            uint32_t distanceStorage;
+            uint64_t xsOffset;
+            uint64_t ysOffset;
+            uint64_t demandsOffset;
+            uint64_t distancesOffset;
+            uint64_t distancesBytes;
+            uint64_t neighboursOffset;
+        };
+        static constexpr char magic[8] = "CVRPBIN";
+        static constexpr uint32_t byteOrderMark = 0x01020304;
+        static constexpr uint64_t alignment = 64;
+
+        std::shared_ptr<const InputFile> m_file;
+        const Header *m_header;
+
+        template <typename T>
+        Span<const T> section(uint64_t offset, uint64_t count) const
+            { return Span<const T>(reinterpret_cast<const T *>(m_file->data() + offset), count); }
+        void checkSection(const char *name, uint64_t offset, uint64_t bytes) const;
+        [[noreturn]] void invalid(const std::string& reason) const __attribute__((cold, noinline));
+};
+
+}//cvrp namespace
+#endif
@@ -0,0 +1,249 @@
+#include "cvrp_checkpoint.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include "cvrp_inputFile.h"
+
+namespace cvrp
+{
+
+namespace
+{
+constexpr uint32_t byteOrderMark = 0x01020304;
+
+/* FNV-1a over 32-bit words */
+uint64_t hashWords(uint64_t hash, const uint32_t *words, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        hash = (hash ^ words[i]) * 0x100000001b3ull;
+    }
+    return hash;
+}
+
+[[noreturn]] void fail(const std::string& name, const std::string& reason) __attribute__((cold, noinline));
+
+void fail(const std::string& name, const std::string& reason)
+{
+    throw std::invalid_argument(name + ": " + reason);
+}
+}
+
+uint64_t Checkpoint::fingerprint(const ModelView& view)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+    const uint32_t capacity = view.vehicleCapacity();
+    hash = hashWords(hash, &capacity, 1);
+    for (int node = 0; node <= view.numberOfClients(); node++)
+    {
+        const uint32_t words[3] = { uint32_t(view.x(node)), uint32_t(view.y(node)), uint32_t(view.demand(node)) };
+        hash = hashWords(hash, words, 3);
+    }
+    return hash;
+}
+
+void Checkpoint::encode(const CheckpointState& state, std::string& out)
+{
+    std::vector<uint32_t> words;
+    for (const auto& solution : state.population)
+    {
+        words.push_back(solution.size());
+        for (const auto& trip : solution)
+        {
+            words.push_back(trip.size());
+            words.insert(words.end(), trip.begin(), trip.end());
+        }
+    }
+    for (const auto& prng : state.prngs)
+    {
+        words.push_back(prng.size());
+        words.insert(words.end(), prng.begin(), prng.end());
+    }
+
+    Header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "CVRPCKP", 8);
+    header.version = version;
+    header.byteOrder = byteOrderMark;
+    header.fingerprint = state.fingerprint;
+    header.generation = state.generation;
+    header.nullGenerations = state.nullGenerations;
+    header.solutions = state.population.size();
+    header.prngs = state.prngs.size();
+    header.words = words.size();
+    header.checksum = hashWords(0xcbf29ce484222325ull, words.data(), words.size());
+    out.assign(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.append(reinterpret_cast<const char *>(words.data()), words.size() * sizeof(uint32_t));
+}
+
+CheckpointState Checkpoint::decode(std::string_view data, const std::string& name)
+{
+    Header header;
+    if (data.size() < sizeof(header))
+    {
+        fail(name, "too short for a checkpoint");
+    }
+    memcpy(&header, data.data(), sizeof(header));
+    if (memcmp(header.magic, "CVRPCKP", 8) != 0)
+    {
+        fail(name, "not a checkpoint");
+    }
+    if (header.byteOrder != byteOrderMark || header.version != version)
+    {
+        fail(name, "checkpoint from another version or byte order");
+    }
+    if (header.words != (data.size() - sizeof(header)) / sizeof(uint32_t) ||
+            (data.size() - sizeof(header)) % sizeof(uint32_t) != 0)
+    {
+        fail(name, "truncated checkpoint");
+    }
+    std::vector<uint32_t> words(header.words);
+    memcpy(words.data(), data.data() + sizeof(header), words.size() * sizeof(uint32_t));
+    if (hashWords(0xcbf29ce484222325ull, words.data(), words.size()) != header.checksum)
+    {
+        fail(name, "checkpoint checksum mismatch");
+    }
+
+    CheckpointState state;
+    state.fingerprint = header.fingerprint;
+    state.generation = header.generation;
+    state.nullGenerations = header.nullGenerations;
+    size_t next = 0;
+    /* Every count is checked against what is left before it is used */
+    const auto take = [&](size_t count)
+    {
+        if (count > words.size() - next)
+        {
+            fail(name, "damaged checkpoint");
+        }
+        const uint32_t *start = words.data() + next;
+        next += count;
+        return start;
+    };
+    state.population.resize(header.solutions);
+    for (auto& solution : state.population)
+    {
+        solution.resize(*take(1));
+        for (auto& trip : solution)
+        {
+            const uint32_t size = *take(1);
+            const uint32_t *ids = take(size);
+            trip.assign(ids, ids + size);
+        }
+    }
+    state.prngs.resize(header.prngs);
+    for (auto& prng : state.prngs)
+    {
+        const uint32_t size = *take(1);
+        const uint32_t *prngWords = take(size);
+        prng.assign(prngWords, prngWords + size);
+    }
+    if (next != words.size())
+    {
+        fail(name, "damaged checkpoint");
+    }
+    return state;
+}
+
+CheckpointState Checkpoint::read(const std::string& path)
+{
+    return decode(InputFile::open(path)->text(), path);
+}
+
+void Checkpoint::write(const std::string& path, std::string_view data)
+{
+    const std::string temporary = path + ".tmp";
+    const int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        throw std::runtime_error("Cannot create " + temporary + ": " + strerror(errno));
+    }
+    while (!data.empty())
+    {
+        const ssize_t count = ::write(fd, data.data(), data.size());
+        if (count < 0 && errno != EINTR)
+        {
+            const std::string reason = strerror(errno);
+            ::close(fd);
+            throw std::runtime_error("Cannot write " + temporary + ": " + reason);
+        }
+        data.remove_prefix(count < 0 ? 0 : count);
+    }
+    /* Close whatever fsync says, then report the first failure */
+    int error = fsync(fd) < 0 ? errno : 0;
+    if (::close(fd) < 0 && error == 0)
+    {
+        error = errno;
+    }
+    if (error == 0 && rename(temporary.c_str(), path.c_str()) < 0)
+    {
+        error = errno;
+    }
+    if (error != 0)
+    {
+        throw std::runtime_error("Cannot save " + path + ": " + strerror(error));
+    }
+}
+
+CheckpointWriter::CheckpointWriter(const std::string& path) :
+    m_path(path), m_hasPending(false), m_done(false), m_thread(&CheckpointWriter::run, this)
+{
+}
+
+CheckpointWriter::~CheckpointWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_done = true;
+    }
+    m_wake.notify_one();
+    m_thread.join();
+}
+
+void CheckpointWriter::submit(Snapshot&& snapshot)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_pending = std::move(snapshot);
+        m_hasPending = true;
+    }
+    m_wake.notify_one();
+}
+
+void CheckpointWriter::run()
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+    for (;;)
+    {
+        m_wake.wait(lock, [this]() { return m_hasPending || m_done; });
+        if (!m_hasPending)
+        {
+            return;
+        }
+        Snapshot snapshot = std::move(m_pending);
+        m_pending = nullptr;
+        m_hasPending = false;
+        lock.unlock();
+        try
+        {
+            const CheckpointState state = snapshot();
+            /* Let go of what it held before writing */
+            snapshot = nullptr;
+            std::string data;
+            Checkpoint::encode(state, data);
+            Checkpoint::write(m_path, data);
+        }
+        catch (const std::exception& error)
+        {
+            fprintf(stderr, "%s\n", error.what());
+        }
+        lock.lock();
+    }
+}
+
+}//cvrp namespace
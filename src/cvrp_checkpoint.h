@@ -0,0 +1,100 @@
+#ifndef CVRP_CHECKPOINT
+#define CVRP_CHECKPOINT
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "cvrp_modelView.h"
+#include "cvrp_solutionReader.h"
+
+namespace cvrp
+{
+/* What an evolution run needs to carry on where it stopped */
+struct CheckpointState
+{
+    /* Of the instance the population belongs to, see Checkpoint::fingerprint */
+    uint64_t fingerprint = 0;
+    uint64_t generation = 0;
+    uint64_t nullGenerations = 0;
+    std::vector<SolutionRoutes> population;
+    /* Generator state of each OpenMP thread, by thread number */
+    std::vector<std::vector<uint32_t>> prngs;
+};
+
+/*
+ * Binary checkpoint file: a fixed header, then one uint32 stream with
+ * every solution (trip count, then each trip's length and client IDs) and
+ * every generator state (word count, then the words), and a checksum of
+ * that stream.  Native byte order; other versions and byte orders, and
+ * truncated or damaged files, are rejected as invalid_argument.
+ */
+class Checkpoint
+{
+    public:
+        static constexpr uint32_t version = 1;
+
+        /* Hash of the capacity, coordinates and demands */
+        static uint64_t fingerprint(const ModelView& view);
+        static void encode(const CheckpointState& state, std::string& out);
+        static CheckpointState decode(std::string_view data, const std::string& name);
+        static CheckpointState read(const std::string& path);
+        /* Through path.tmp and a rename, so that a crash mid-write keeps the previous checkpoint */
+        static void write(const std::string& path, std::string_view data);
+
+    private:
+        struct Header
+        {
+            char magic[8];
+            uint32_t version;
+            uint32_t byteOrder;
+            uint64_t fingerprint;
+            uint64_t generation;
+            uint64_t nullGenerations;
+            uint64_t solutions;
+            uint64_t prngs;
+            uint64_t words;
+            uint64_t checksum;
+        };
+};
+
+/*
+ * Builds, encodes and writes checkpoints on a thread of its own.  The
+ * solver submits a snapshot, a function called on that thread to build the
+ * state, so it only pays for taking hold of its state rather than copying
+ * it; whatever the snapshot refers to must not change until it has been
+ * called.  A checkpoint submitted while another is still being written
+ * replaces any older one waiting; the destructor writes the last one
+ * before returning.  Write errors go to stderr.
+ */
+class CheckpointWriter
+{
+    public:
+        explicit CheckpointWriter(const std::string& path);
+        ~CheckpointWriter();
+
+        CheckpointWriter(const CheckpointWriter&) = delete;
+        CheckpointWriter& operator = (const CheckpointWriter&) = delete;
+
+        using Snapshot = std::function<CheckpointState()>;
+
+        void submit(Snapshot&& snapshot);
+
+    private:
+        const std::string m_path;
+        std::mutex m_lock;
+        std::condition_variable m_wake;
+        Snapshot m_pending;
+        bool m_hasPending;
+        bool m_done;
+        std::thread m_thread;
+
+        void run();
+};
+
+}//cvrp namespace
+#endif
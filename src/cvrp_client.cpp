@@ -0,0 +1,165 @@
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <climits>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/*
+ * Test client for cvrp --serve <socket>.  With instance paths it sends one
+ * request per instance, otherwise it forwards the request lines of stdin,
+ * and prints every reply line as it arrives.
+ */
+static int usage()
+{
+    std::cerr << "Usage: cvrp-client <socket> [--time seconds] [--seed N] [instance...]" << std::endl
+        << "       cvrp-client <socket> < requests.jsonl" << std::endl;
+    return 2;
+}
+
+static void sendAll(int fd, const std::string& data)
+{
+    size_t sent = 0;
+    while (sent < data.size())
+    {
+        const ssize_t count = ::write(fd, data.data() + sent, data.size() - sent);
+        if (count < 0 && errno != EINTR)
+        {
+            perror("cvrp-client: write");
+            exit(1);
+        }
+        sent += count < 0 ? 0 : count;
+    }
+}
+
+/* Copies reply lines to stdout until count of them have arrived */
+static bool receiveReplies(int fd, size_t count, std::string& pending)
+{
+    char chunk[1 << 16];
+    while (count > 0)
+    {
+        size_t newline;
+        while (count > 0 && (newline = pending.find('\n')) != std::string::npos)
+        {
+            fwrite(pending.data(), 1, newline + 1, stdout);
+            fflush(stdout);
+            pending.erase(0, newline + 1);
+            count--;
+        }
+        if (count == 0)
+        {
+            break;
+        }
+        const ssize_t got = ::read(fd, chunk, sizeof(chunk));
+        if (got < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (got <= 0)
+        {
+            return false;
+        }
+        pending.append(chunk, got);
+    }
+    return true;
+}
+
+static std::string quoted(const std::string& text)
+{
+    std::string out = "\"";
+    for (const char c : text)
+    {
+        if (c == '"' || c == '\\')
+        {
+            out += '\\';
+        }
+        out += c;
+    }
+    return out + '"';
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        return usage();
+    }
+    const std::string socketPath = argv[1];
+    std::string timeLimit;
+    std::string seed;
+    int arg = 2;
+    for (; arg < argc && strncmp(argv[arg], "--", 2) == 0; arg++)
+    {
+        if (strcmp(argv[arg], "--time") == 0 && arg + 1 < argc)
+        {
+            timeLimit = argv[++arg];
+        }
+        else if (strcmp(argv[arg], "--seed") == 0 && arg + 1 < argc)
+        {
+            seed = argv[++arg];
+        }
+        else
+        {
+            return usage();
+        }
+    }
+
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path))
+    {
+        return usage();
+    }
+    memcpy(address.sun_path, socketPath.c_str(), socketPath.size());
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) < 0)
+    {
+        std::cerr << "cvrp-client: cannot connect to " << socketPath << ": " << strerror(errno) << std::endl;
+        return 1;
+    }
+
+    std::string pending;
+    bool complete = true;
+    if (arg < argc)
+    {
+        /* The server resolves paths from its own directory, so send absolute ones */
+        std::string requests;
+        for (int i = arg; i < argc; i++)
+        {
+            char resolved[PATH_MAX];
+            const std::string path = realpath(argv[i], resolved) ? resolved : argv[i];
+            requests += "{\"id\":" + std::to_string(i - arg) + ",\"instance\":" + quoted(path);
+            requests += timeLimit.empty() ? "" : ",\"timeLimit\":" + timeLimit;
+            requests += seed.empty() ? "" : ",\"seed\":" + seed;
+            requests += "}\n";
+        }
+        sendAll(fd, requests);
+        complete = receiveReplies(fd, argc - arg, pending);
+    }
+    else
+    {
+        /* One request at a time, each reply before the next line is read */
+        std::string line;
+        while (complete && std::getline(std::cin, line))
+        {
+            if (line.find_first_not_of(" \t\r") == std::string::npos)
+            {
+                continue;
+            }
+            sendAll(fd, line + "\n");
+            complete = receiveReplies(fd, 1, pending);
+        }
+    }
+    close(fd);
+    if (!complete)
+    {
+        std::cerr << "cvrp-client: the server closed the connection" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include "cvrp_binaryInstance.h"
+#include "cvrp_dataModel.h"
+
+using namespace cvrp;
+
+/*
+ * Converts a JSON or .vrp instance into the mapped binary format, see
+ * cvrp_binaryInstance.h.  The distance matrix is stored when the chosen
+ * storage keeps one; computed storage writes coordinates only.
+ */
+static int usage()
+{
+    std::cerr << "Usage: cvrp-convert [--storage auto|dense|triangular|computed] [--neighbours K]"
+        << " [--no-distances] [--no-neighbours] <instance.json|.vrp> <instance.bin>" << std::endl;
+    return 2;
+}
+
+int main(int argc, char *argv[])
+{
+    DataModelOptions options;
+    bool distances = true;
+    bool neighbours = true;
+    int arg = 1;
+    for (; arg < argc && strncmp(argv[arg], "--", 2) == 0; arg++)
+    {
+        if (strcmp(argv[arg], "--storage") == 0 && arg + 1 < argc)
+        {
+            options.distanceStorage = DistanceMatrix::parseStorage(argv[++arg]);
+        }
+        else if (strcmp(argv[arg], "--neighbours") == 0 && arg + 1 < argc)
+        {
+            options.neighbourCount = atoi(argv[++arg]);
+        }
+        else if (strcmp(argv[arg], "--no-distances") == 0)
+        {
+            distances = false;
+        }
+        else if (strcmp(argv[arg], "--no-neighbours") == 0)
+        {
+            neighbours = false;
+        }
+        else
+        {
+            return usage();
+        }
+    }
+    if (argc - arg != 2)
+    {
+        return usage();
+    }
+    if (!distances)
+    {
+        options.distanceStorage = DistanceStorage::Computed;
+    }
+
+    std::unique_ptr<DataModel> dataModel = DataModel::load(InputFile::open(argv[arg]), options);
+    const DataModel& model = *dataModel;
+
+    std::ofstream out(argv[arg + 1], std::ofstream::binary | std::ofstream::trunc);
+    BinaryInstance::write(model, out, distances, neighbours);
+    out.close();
+    std::cerr << model.numberOfClients() << " clients, " << model.distances().describe()
+        << (neighbours ? ", " + std::to_string(model.neighbourLists().count()) + " neighbours" : std::string())
+        << " written to " << argv[arg + 1] << std::endl;
+    return 0;
+}
@@ -2,120 +2,129 @@
 
 #include <stdexcept>
 #include "cvrp_util.h"
+#include "cvrp_binaryInstance.h"
+#include "cvrp_jsonReader.h"
+#include "cvrp_vrpReader.h"
 
 namespace cvrp
 {
 
-DataModel::DataModel(std::stringstream& jsonData)
+DataModel::DataModel(std::stringstream& jsonData, const DataModelOptions& options) :
+    DataModel(JsonReader::parse(jsonData.str(), "JSON instance"), options)
 {
-    Json::Value root;
-    jsonData >> root;
-    populateData(root);
 }
 
-double DataModel::getClientDistanceFromDepot(int clientId) const
+DataModel::DataModel(InstanceData&& data, const DataModelOptions& options) :
+    m_data(std::move(data))
 {
-    Clients::const_iterator it = m_clientDemands.find(clientId);
-    if(it == m_clientDemands.end())
-    {
-        std::stringstream error;
-        error << "Invalid client ID provided: " << clientId;
-        throw std::invalid_argument(error.str());
-    }
-    return Util::distance(m_depot.first, m_depot.second, it->second.position.first, it->second.position.second);
+    useArrays(Span<const int>(m_data.xs.data(), m_data.xs.size()),
+              Span<const int>(m_data.ys.data(), m_data.ys.size()),
+              Span<const int>(m_data.demands.data(), m_data.demands.size()),
+              m_data.vehicleCapacity);
+    buildIndexes(options, false, false);
 }
 
-double DataModel::distanceBetweenClients(int client1Id, int client2Id) const
+DataModel::DataModel(const BinaryInstance& instance, const DataModelOptions& options) :
+    m_file(instance.file())
 {
-    if(m_clientDemands.find(client1Id) == m_clientDemands.end()
-            || m_clientDemands.find(client2Id) == m_clientDemands.end())
+    useArrays(instance.xs(), instance.ys(), instance.demands(), instance.vehicleCapacity());
+    const bool haveDistances = instance.hasDistances() &&
+        (options.distanceStorage == DistanceStorage::Auto || options.distanceStorage == instance.distanceStorage());
+    if (haveDistances)
+    {
+        m_distances.adopt(instance.distanceStorage(), instance.distances(), m_xs.size());
+    }
+    const bool haveNeighbours = instance.hasNeighbours() &&
+        instance.neighbourCount() == NeighbourLists::effectiveCount(options.neighbourCount, m_xs.size());
+    if (haveNeighbours)
     {
-        std::stringstream error;
-        error << "Invalid client IDs provided: " << client1Id << " and " << client2Id;
-        throw std::invalid_argument(error.str());
+        m_neighbours.adopt(instance.neighbours(), instance.neighbourCount());
     }
-    Client c1 = getClient(client1Id);
-    Client c2 = getClient(client2Id);
-    return Util::distance(c1.position.first, c1.position.second, c2.position.first, c2.position.second);
+    buildIndexes(options, haveDistances, haveNeighbours);
 }
 
-int DataModel::getClientDemand(int clientId) const
+std::unique_ptr<DataModel> DataModel::load(std::shared_ptr<const InputFile> file, const DataModelOptions& options)
 {
-    if(m_clientDemands.find(clientId) == m_clientDemands.end())
+    if (BinaryInstance::isBinary(*file))
+    {
+        return std::unique_ptr<DataModel>(new DataModel(BinaryInstance(file), options));
+    }
+    const std::string_view text = file->text();
+    if (VrpReader::isVrp(text))
     {
-        std::stringstream error;
-        error << "Invalid client ID provided: " << clientId;
-        throw std::invalid_argument(error.str());
+        return std::unique_ptr<DataModel>(new DataModel(VrpReader::parse(text, file->path()), options));
     }
-    return getClient(clientId).demand;
+    return std::unique_ptr<DataModel>(new DataModel(JsonReader::parse(text, file->path()), options));
 }
 
-const Coord& DataModel::getClientLocation(int clientId) const
+void DataModel::useArrays(Span<const int> xs, Span<const int> ys, Span<const int> demands, int vehicleCapacity)
 {
-    if(m_clientDemands.find(clientId) == m_clientDemands.end())
+    m_xs = xs;
+    m_ys = ys;
+    m_demands = demands;
+    m_vehicleCpacity = vehicleCapacity;
+    m_depot = Coord(xs[0], ys[0]);
+}
+
+void DataModel::buildIndexes(const DataModelOptions& options, bool haveDistances, bool haveNeighbours)
+{
+    if (!haveDistances)
+    {
+        m_distances.build(clientXs(), clientYs(), options.distanceStorage);
+    }
+    m_spatialIndex.build(clientXs(), clientYs());
+    if (!haveNeighbours)
     {
-        std::stringstream error;
-        error << "Invalid client ID provided: " << clientId;
-        throw std::invalid_argument(error.str());
+        m_neighbours.build(clientXs(), clientYs(), options.neighbourCount, m_spatialIndex);
     }
-    return getClient(clientId).position;
+    m_view.reset(new ModelView(clientXs(), clientYs(), clientDemands(), m_distances, m_vehicleCpacity, m_neighbours));
 }
 
-int DataModel::numberOfClients() const
+void DataModel::invalidClient(int clientId)
 {
-    return m_clientDemands.size();
+    std::stringstream error;
+    error << "Invalid client ID provided: " << clientId;
+    throw std::invalid_argument(error.str());
 }
 
-std::vector<int> DataModel::getClients() const
+double DataModel::getClientDistanceFromDepot(int clientId) const
 {
-	std::vector<int> clients;
-    for (Clients::const_iterator it = m_clientDemands.begin();
-            it != m_clientDemands.end(); ++it)
-    {
-        clients.push_back(it->first);
-    }
-    return clients;
+    checkClient(clientId);
+    return distance(0, clientId);
 }
 
-void DataModel::populateData(Json::Value& jsonObj)
+double DataModel::distanceBetweenClients(int client1Id, int client2Id) const
 {
-    m_vehicleCpacity = jsonObj.get("vehicleCapacity", -1).asInt();
-    if (m_vehicleCpacity < 0)
-    {
-        std::stringstream error;
-        error << "Invalid Vehicle Capacity: " << m_vehicleCpacity;
-        throw std::invalid_argument(error.str());
-    }
+    checkClient(client1Id);
+    checkClient(client2Id);
+    return distance(client1Id, client2Id);
+}
 
-    int dx = jsonObj["depot"].get("x", -1).asInt();
-    int dy = jsonObj["depot"].get("y", -1).asInt();
-    if (dx < 0 || dy < 0)
-    {
-        std::stringstream error;
-        error << "Invalid Data OR error parsing json for 'depot'" << jsonObj["depot"];
-        throw std::invalid_argument(error.str());
-    }
-    m_depot = std::pair<int, int>(dx, dy);
+int DataModel::getClientDemand(int clientId) const
+{
+    checkClient(clientId);
+    return m_demands[clientId];
+}
+
+Coord DataModel::getClientLocation(int clientId) const
+{
+    checkClient(clientId);
+    return Coord(m_xs[clientId], m_ys[clientId]);
+}
+
+int DataModel::numberOfClients() const
+{
+    return m_demands.size() - 1;
+}
 
-    Json::Value& clients = jsonObj["nodes"];
-    for (unsigned int i = 0; i < clients.size(); i++)
+std::vector<int> DataModel::getClients() const
+{
+	std::vector<int> clients;
+    for (int i = 1; i < (int) m_demands.size(); i++)
     {
-        Client currClient;
-        int x = clients[i].get("x", -1).asInt();
-        int y = clients[i].get("y", -1).asInt();
-        int demand = clients[i].get("demand", -1).asInt();
-        if (x < 0 || y < 0 || demand < 0)
-        {
-            std::stringstream error;
-            error << "Invalid Data OR error parsing json for client: " << clients[i];
-            throw std::invalid_argument(error.str());
-        }
-
-        currClient.position = std::pair<int, int>(x, y);
-        currClient.demand = demand;
-
-        m_clientDemands.insert(std::make_pair(i+1, currClient));
+        clients.push_back(i);
     }
+    return clients;
 }
 
 }//cvrp namespace
@@ -1,31 +1,83 @@
 #ifndef CVRP_DATA_MODEL
 #define CVRP_DATA_MODEL
 
+#include <sstream>
 #include "cvrp_idataModel.h"
-#include "json/json.h"
+#include "cvrp_modelView.h"
+#include "cvrp_distanceMatrix.h"
+#include "cvrp_neighbourLists.h"
+#include "cvrp_util.h"
+#include "cvrp_inputFile.h"
 
 namespace cvrp
 {
-class DataModel : public IDataModel
+class BinaryInstance;
+
+/* Parsed instance arrays, index 0 is the depot with demand 0 */
+struct InstanceData
+{
+    int vehicleCapacity = 0;
+    AlignedVector<int> xs;
+    AlignedVector<int> ys;
+    AlignedVector<int> demands;
+};
+
+struct DataModelOptions
+{
+    /* Length of each client's nearest-neighbour candidate list */
+    int neighbourCount = NeighbourLists::defaultCount;
+    DistanceStorage distanceStorage = DistanceStorage::Auto;
+};
+
+class DataModel final : public IDataModel
 {
     public:
-        DataModel(std::stringstream& jsonData);
+        /* Client IDs are validated here; view() then serves them unchecked */
+        DataModel(std::stringstream& jsonData, const DataModelOptions& options = DataModelOptions());
+        DataModel(InstanceData&& data, const DataModelOptions& options = DataModelOptions());
+        /* Uses the mapped arrays in place, and any stored matrix or neighbour lists that fit the options */
+        DataModel(const BinaryInstance& instance, const DataModelOptions& options = DataModelOptions());
+        /* Binary, .vrp or JSON, told apart by the content */
+        static std::unique_ptr<DataModel> load(std::shared_ptr<const InputFile> file, const DataModelOptions& options = DataModelOptions());
 
         double distanceBetweenClients(int client1Id, int client2Id) const;
         int vehicleCapacity() const { return m_vehicleCpacity; }
         const Coord& depot() const { return m_depot; }
         int getClientDemand(int clientId) const;
-        const Coord& getClientLocation(int clientId) const;
+        Coord getClientLocation(int clientId) const;
         int numberOfClients() const;
 	std::vector<int> getClients() const;
         double getClientDistanceFromDepot(int clientId) const;
+        const ModelView& view() const { return *m_view; }
+
+        /* Per-client arrays indexed by client ID, index 0 is the depot */
+        Span<const int> clientXs() const { return m_xs; }
+        Span<const int> clientYs() const { return m_ys; }
+        Span<const int> clientDemands() const { return m_demands; }
+        Span<const int> neighbours(int clientId) const { checkClient(clientId); return m_neighbours.of(clientId); }
+        const SpatialGrid& spatialIndex() const { return m_spatialIndex; }
+        const DistanceMatrix& distances() const { return m_distances; }
+        const NeighbourLists& neighbourLists() const { return m_neighbours; }
+
+        bool isValidClient(int clientId) const { return clientId > 0 && clientId < (int) m_demands.size(); }
+        void checkClient(int clientId) const { if (!isValidClient(clientId)) invalidClient(clientId); }
 
     private:
-        Clients m_clientDemands;
+        InstanceData m_data;
+        std::shared_ptr<const InputFile> m_file;
+        Span<const int> m_xs;
+        Span<const int> m_ys;
+        Span<const int> m_demands;
         int m_vehicleCpacity;
         Coord m_depot;
-        void populateData(Json::Value& jsonObj);
-	const Client& getClient(int clientId) const { return m_clientDemands.at(clientId); }
+        DistanceMatrix m_distances;
+        SpatialGrid m_spatialIndex;
+        NeighbourLists m_neighbours;
+        std::unique_ptr<ModelView> m_view;
+        void useArrays(Span<const int> xs, Span<const int> ys, Span<const int> demands, int vehicleCapacity);
+        void buildIndexes(const DataModelOptions& options, bool haveDistances, bool haveNeighbours);
+        [[noreturn]] static void invalidClient(int clientId) __attribute__((cold, noinline));
+        Cost distance(int fromId, int toId) const { return m_distances(fromId, toId); }
 };
 
 }//cvrp namespace
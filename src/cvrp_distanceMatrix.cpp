@@ -0,0 +1,181 @@
+#include "cvrp_distanceMatrix.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+
+namespace cvrp
+{
+
+void DistanceMatrix::build(Span<const int> xs, Span<const int> ys, DistanceStorage storage)
+{
+    m_xs = xs;
+    m_ys = ys;
+    if (resolve(storage, xs.size()) == DistanceStorage::Computed)
+    {
+        m_storage = DistanceStorage::Computed;
+        m_size = xs.size();
+        m_ownedDense.clear();
+        m_ownedTriangular.clear();
+        return;
+    }
+    if (storage == DistanceStorage::Cached)
+    {
+        throw std::invalid_argument("Cached distances need a DistanceRowCache, see LazyDataModel");
+    }
+    m_storage = resolve(storage, xs.size()) == DistanceStorage::Dense ? DistanceStorage::Dense : DistanceStorage::Triangular;
+    m_size = xs.size();
+    m_ownedDense.clear();
+    m_ownedTriangular.clear();
+    if (m_storage == DistanceStorage::Dense)
+    {
+        m_ownedDense.resize(m_size * m_size);
+    }
+    else
+    {
+        m_ownedTriangular.resize(m_size * (m_size + 1) / 2);
+    }
+    m_dense = m_ownedDense.data();
+    m_triangular = m_ownedTriangular.data();
+
+    /* Whole rows through the batch kernel, which also keeps the writes sequential */
+    #pragma omp parallel
+    {
+        std::vector<double> row;
+#pragma omp for schedule(dynamic, 16)
+        for (size_t i = 0; i < m_size; i++)
+        {
+            const size_t length = m_storage == DistanceStorage::Dense ? m_size : i + 1;
+            row.resize(length);
+            Util::distancesFrom(xs[i], ys[i], xs.data(), ys.data(), length, row.data());
+            if (m_storage == DistanceStorage::Dense)
+            {
+                std::transform(row.begin(), row.end(), m_ownedDense.begin() + i * m_size, Util::toCost);
+            }
+            else
+            {
+                std::transform(row.begin(), row.end(), m_ownedTriangular.begin() + i * (i + 1) / 2, Util::toCost);
+            }
+        }
+    }
+}
+
+void DistanceMatrix::attach(const DistanceRowCache& cache, size_t size)
+{
+    m_storage = DistanceStorage::Cached;
+    m_size = size;
+    m_ownedDense.clear();
+    m_ownedTriangular.clear();
+    m_cache = &cache;
+}
+
+void DistanceMatrix::adopt(DistanceStorage storage, const void *data, size_t size)
+{
+    if (storage != DistanceStorage::Dense && storage != DistanceStorage::Triangular)
+    {
+        throw std::invalid_argument("Only dense and triangular distance matrices can be adopted");
+    }
+    m_storage = storage;
+    m_size = size;
+    m_ownedDense.clear();
+    m_ownedTriangular.clear();
+    m_dense = static_cast<const DenseDistance *>(data);
+    m_triangular = static_cast<const PackedDistance *>(data);
+}
+
+const void *DistanceMatrix::rawData() const
+{
+    switch (m_storage)
+    {
+    case DistanceStorage::Dense:
+        return m_dense;
+    case DistanceStorage::Triangular:
+        return m_triangular;
+    default:
+        return nullptr;
+    }
+}
+
+size_t DistanceMatrix::rawBytes() const
+{
+    return rawBytes(m_storage, m_size);
+}
+
+size_t DistanceMatrix::rawBytes(DistanceStorage storage, size_t size)
+{
+    switch (storage)
+    {
+    case DistanceStorage::Dense:
+        return size * size * sizeof(DenseDistance);
+    case DistanceStorage::Triangular:
+        return size * (size + 1) / 2 * sizeof(PackedDistance);
+    default:
+        return 0;
+    }
+}
+
+size_t DistanceMatrix::memoryFootprint() const
+{
+    if (m_storage == DistanceStorage::Cached)
+    {
+        return m_cache->capacityRows() * m_cache->rowBytes();
+    }
+    return rawBytes();
+}
+
+std::string DistanceMatrix::describe() const
+{
+#ifdef CVRP_ROUNDED_DISTANCES
+    static const char *names[] = {"auto", "dense int32", "triangular int32", "computed", "row-cached"};
+#else
+    static const char *names[] = {"auto", "dense float64", "triangular float32", "computed", "row-cached"};
+#endif
+    char buf[128];
+    snprintf(buf, sizeof(buf), "%s distance matrix, %zu nodes, %.1f MiB",
+            names[static_cast<int>(m_storage)], m_size, memoryFootprint() / 1048576.0);
+    return buf;
+}
+
+DistanceStorage DistanceMatrix::resolve(DistanceStorage storage, size_t size)
+{
+    if (storage != DistanceStorage::Auto)
+    {
+        return storage;
+    }
+    if (size * size * sizeof(double) <= autoDenseLimitBytes)
+    {
+        return DistanceStorage::Dense;
+    }
+    if (size * (size + 1) / 2 * sizeof(float) <= autoTriangularLimitBytes)
+    {
+        return DistanceStorage::Triangular;
+    }
+    return DistanceStorage::Computed;
+}
+
+DistanceStorage DistanceMatrix::parseStorage(const std::string& name)
+{
+    if (name == "auto")
+    {
+        return DistanceStorage::Auto;
+    }
+    if (name == "dense")
+    {
+        return DistanceStorage::Dense;
+    }
+    if (name == "triangular")
+    {
+        return DistanceStorage::Triangular;
+    }
+    if (name == "computed")
+    {
+        return DistanceStorage::Computed;
+    }
+    if (name == "lazy")
+    {
+        return DistanceStorage::Cached;
+    }
+    throw std::invalid_argument("Unknown distance storage: " + name);
+}
+
+}//cvrp namespace
@@ -0,0 +1,133 @@
+#ifndef CVRP_DISTANCE_MATRIX
+#define CVRP_DISTANCE_MATRIX
+
+#include <string>
+#include "cvrp_util.h"
+#include "cvrp_distanceRowCache.h"
+
+namespace cvrp
+{
+enum class DistanceStorage
+{
+    Auto,       /* Dense, triangular or computed depending on the footprint */
+    Dense,      /* Full (n+1)x(n+1) doubles (int32 with ROUNDED=y) */
+    Triangular, /* One triangle, diagonal included, as float (int32 with ROUNDED=y) */
+    Computed,   /* Nothing stored, every lookup recomputes from coordinates */
+    Cached      /* Rows on demand in a bounded DistanceRowCache, see LazyDataModel */
+};
+
+/*
+ * Cache of all pairwise distances, index 0 is the depot.  The triangular
+ * mode halves the element count and the element size: 30k clients need
+ * about 1.8 GB instead of 7.2 GB, at the cost of float precision.
+ */
+class DistanceMatrix
+{
+    public:
+        static constexpr size_t autoDenseLimitBytes = size_t(256) << 20;
+        static constexpr size_t autoTriangularLimitBytes = size_t(4) << 30;
+
+        DistanceMatrix() : m_storage(DistanceStorage::Dense), m_size(0), m_dense(nullptr), m_triangular(nullptr), m_cache(nullptr) {}
+
+        void build(Span<const int> xs, Span<const int> ys, DistanceStorage storage);
+        /* Materialise distance(i, j) for every 0 <= i < j < size (Computed is stored triangular) */
+        template <typename Distance>
+        void build(size_t size, DistanceStorage storage, Distance distance);
+        /* Serve every lookup from a row cache owned by the caller */
+        void attach(const DistanceRowCache& cache, size_t size);
+        /* Use a Dense or Triangular matrix stored elsewhere, laid out as rawData() */
+        void adopt(DistanceStorage storage, const void *data, size_t size);
+
+#ifdef CVRP_ROUNDED_DISTANCES
+        typedef int32_t DenseDistance;
+        typedef int32_t PackedDistance;
+#else
+        typedef double DenseDistance;
+        typedef float PackedDistance;
+#endif
+
+        Cost operator () (int fromId, int toId) const
+        {
+            switch (m_storage)
+            {
+            case DistanceStorage::Dense:
+                return m_dense[fromId * m_size + toId];
+            case DistanceStorage::Triangular:
+                {
+                    size_t hi = fromId > toId ? fromId : toId;
+                    size_t lo = fromId > toId ? toId : fromId;
+                    return m_triangular[hi * (hi + 1) / 2 + lo];
+                }
+            case DistanceStorage::Computed:
+                return Util::toCost(Util::distance(m_xs[fromId], m_ys[fromId], m_xs[toId], m_ys[toId]));
+            default:
+                return Util::toCost((*m_cache)(fromId, toId));
+            }
+        }
+
+        DistanceStorage storage() const { return m_storage; }
+        const void *rawData() const;
+        size_t rawBytes() const;
+        static size_t rawBytes(DistanceStorage storage, size_t size);
+        size_t size() const { return m_size; }
+        size_t memoryFootprint() const;
+        std::string describe() const;
+
+        static DistanceStorage resolve(DistanceStorage storage, size_t size);
+        static DistanceStorage parseStorage(const std::string& name);
+
+    private:
+        DistanceStorage m_storage;
+        size_t m_size;
+        std::vector<DenseDistance> m_ownedDense;
+        std::vector<PackedDistance> m_ownedTriangular;
+        const DenseDistance *m_dense;
+        const PackedDistance *m_triangular;
+        Span<const int> m_xs;
+        Span<const int> m_ys;
+        const DistanceRowCache *m_cache;
+};
+
+template <typename Distance>
+void DistanceMatrix::build(size_t size, DistanceStorage storage, Distance distance)
+{
+    m_storage = resolve(storage, size);
+    if (m_storage != DistanceStorage::Dense)
+    {
+        m_storage = DistanceStorage::Triangular;
+    }
+    m_size = size;
+    m_ownedDense.clear();
+    m_ownedTriangular.clear();
+    if (m_storage == DistanceStorage::Dense)
+    {
+        m_ownedDense.assign(size * size, 0);
+    }
+    else
+    {
+        m_ownedTriangular.assign(size * (size + 1) / 2, 0);
+    }
+    m_dense = m_ownedDense.data();
+    m_triangular = m_ownedTriangular.data();
+
+    #pragma omp parallel for schedule(dynamic, 16)
+    for (size_t i = 0; i < size; i++)
+    {
+        for (size_t j = i + 1; j < size; j++)
+        {
+            Cost d = Util::toCost(distance(i, j));
+            if (m_storage == DistanceStorage::Dense)
+            {
+                m_ownedDense[i * size + j] = d;
+                m_ownedDense[j * size + i] = d;
+            }
+            else
+            {
+                m_ownedTriangular[j * (j + 1) / 2 + i] = d;
+            }
+        }
+    }
+}
+
+}//cvrp namespace
+#endif
@@ -0,0 +1,158 @@
+#include "cvrp_distanceRowCache.h"
+
+#include <algorithm>
+
+namespace cvrp
+{
+
+static std::atomic<unsigned long> nextCacheId{1};
+
+/* Only the owning thread increments, so a plain load and store will do */
+static void increment(std::atomic<unsigned long>& counter)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+DistanceRowCache::DistanceRowCache(Span<const int> xs, Span<const int> ys, size_t capacityBytes) :
+    m_xs(xs),
+    m_ys(ys),
+    m_capacityRows(std::max<size_t>(1, capacityBytes / std::max<size_t>(1, xs.size() * sizeof(double)))),
+    m_id(nextCacheId++),
+    m_rows(xs.size()),
+    m_referenced(new std::atomic<bool>[xs.size()]),
+    m_shards(new Shard[shardCount]),
+    m_isResident(xs.size(), false),
+    m_hand(0)
+{
+    for (size_t i = 0; i < xs.size(); i++)
+    {
+        m_referenced[i] = false;
+    }
+}
+
+double DistanceRowCache::operator () (int fromId, int toId) const
+{
+    static thread_local struct
+    {
+        unsigned long cacheId = 0;
+        int fromId = -1;
+        std::shared_ptr<const Row> row;
+        Counters *counters = nullptr;
+    } last;
+
+    if (last.cacheId != m_id)
+    {
+        last.counters = &threadCounters();
+        last.cacheId = m_id;
+        last.fromId = -1;
+    }
+    if (last.fromId != fromId)
+    {
+        last.row = row(fromId, *last.counters);
+        last.fromId = fromId;
+    }
+    else
+    {
+        increment(last.counters->hits);
+    }
+    return (*last.row)[toId];
+}
+
+DistanceRowCache::Counters& DistanceRowCache::threadCounters() const
+{
+    const std::thread::id self = std::this_thread::get_id();
+    std::lock_guard<std::mutex> guard(m_countersLock);
+    for (const auto& counters : m_counters)
+    {
+        if (counters->thread == self)
+        {
+            return *counters;
+        }
+    }
+    m_counters.emplace_back(new Counters);
+    m_counters.back()->thread = self;
+    return *m_counters.back();
+}
+
+std::shared_ptr<const DistanceRowCache::Row> DistanceRowCache::row(int fromId, Counters& counters) const
+{
+    {
+        std::lock_guard<std::mutex> guard(shard(fromId).lock);
+        if (m_rows[fromId])
+        {
+            increment(counters.hits);
+            m_referenced[fromId].store(true, std::memory_order_relaxed);
+            return m_rows[fromId];
+        }
+    }
+    increment(counters.misses);
+    return load(fromId);
+}
+
+std::shared_ptr<const DistanceRowCache::Row> DistanceRowCache::load(int fromId) const
+{
+    /* Compute outside any lock, another thread may race us to the same row */
+    auto fresh = std::make_shared<Row>(m_xs.size());
+    Util::distancesFrom(m_xs[fromId], m_ys[fromId], m_xs.data(), m_ys.data(), m_xs.size(), fresh->data());
+
+    std::lock_guard<std::mutex> clockGuard(m_clockLock);
+    if (m_isResident[fromId])
+    {
+        return fresh;
+    }
+    if (m_resident.size() < m_capacityRows)
+    {
+        m_resident.push_back(fromId);
+    }
+    else
+    {
+        /* CLOCK: skip (and clear) recently referenced rows */
+        while (m_referenced[m_resident[m_hand]].exchange(false, std::memory_order_relaxed))
+        {
+            m_hand = (m_hand + 1) % m_resident.size();
+        }
+        int victim = m_resident[m_hand];
+        {
+            std::lock_guard<std::mutex> guard(shard(victim).lock);
+            m_rows[victim].reset();
+        }
+        m_isResident[victim] = false;
+        m_resident[m_hand] = fromId;
+        m_hand = (m_hand + 1) % m_resident.size();
+    }
+    m_isResident[fromId] = true;
+    m_referenced[fromId].store(true, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> guard(shard(fromId).lock);
+    m_rows[fromId] = fresh;
+    return fresh;
+}
+
+size_t DistanceRowCache::residentRows() const
+{
+    std::lock_guard<std::mutex> clockGuard(m_clockLock);
+    return m_resident.size();
+}
+
+unsigned long DistanceRowCache::hits() const
+{
+    std::lock_guard<std::mutex> guard(m_countersLock);
+    unsigned long total = 0;
+    for (const auto& counters : m_counters)
+    {
+        total += counters->hits.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+unsigned long DistanceRowCache::misses() const
+{
+    std::lock_guard<std::mutex> guard(m_countersLock);
+    unsigned long total = 0;
+    for (const auto& counters : m_counters)
+    {
+        total += counters->misses.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+}//cvrp namespace
@@ -0,0 +1,80 @@
+#ifndef CVRP_DISTANCE_ROW_CACHE
+#define CVRP_DISTANCE_ROW_CACHE
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "cvrp_util.h"
+
+namespace cvrp
+{
+/*
+ * Bounded cache of distance rows, filled on demand.  A row holds the
+ * distances from one node to every node and is evicted with the CLOCK
+ * policy once the memory cap is reached.
+ *
+ * Lookups are thread-safe.  Each thread remembers the last row it used,
+ * so a run of lookups from the same node (the inner loop of
+ * VehicleTrip::optimiseCost) takes no lock at all.  Evicted rows stay
+ * alive while a thread still references them, so the cap can be
+ * exceeded by at most one row per thread.  Hits and misses are counted
+ * per thread, without read-modify-writes, and summed by hits()/misses().
+ */
+class DistanceRowCache
+{
+    public:
+        DistanceRowCache(Span<const int> xs, Span<const int> ys, size_t capacityBytes);
+
+        DistanceRowCache(const DistanceRowCache&) = delete;
+        DistanceRowCache& operator = (const DistanceRowCache&) = delete;
+
+        double operator () (int fromId, int toId) const;
+
+        size_t capacityRows() const { return m_capacityRows; }
+        size_t rowBytes() const { return m_xs.size() * sizeof(double); }
+        size_t residentRows() const;
+        unsigned long hits() const;
+        unsigned long misses() const;
+
+    private:
+        typedef std::vector<double> Row;
+        static constexpr int shardCount = 64;
+
+        struct alignas(64) Shard
+        {
+            std::mutex lock;
+        };
+
+        /* Written only by its thread, read by anyone */
+        struct alignas(64) Counters
+        {
+            std::thread::id thread;
+            std::atomic<unsigned long> hits{0};
+            std::atomic<unsigned long> misses{0};
+        };
+
+        Span<const int> m_xs;
+        Span<const int> m_ys;
+        size_t m_capacityRows;
+        unsigned long m_id;
+        /* Row pointers are guarded by their shard's lock */
+        mutable std::vector<std::shared_ptr<const Row>> m_rows;
+        mutable std::unique_ptr<std::atomic<bool>[]> m_referenced;
+        mutable std::unique_ptr<Shard[]> m_shards;
+        /* CLOCK state, guarded by m_clockLock (taken before any shard lock) */
+        mutable std::mutex m_clockLock;
+        mutable std::vector<int> m_resident;
+        mutable std::vector<bool> m_isResident;
+        mutable size_t m_hand;
+        mutable std::mutex m_countersLock;
+        mutable std::vector<std::unique_ptr<Counters>> m_counters;
+
+        Shard& shard(int nodeId) const { return m_shards[nodeId % shardCount]; }
+        Counters& threadCounters() const;
+        std::shared_ptr<const Row> row(int fromId, Counters& counters) const;
+        std::shared_ptr<const Row> load(int fromId) const;
+};
+
+}//cvrp namespace
+#endif
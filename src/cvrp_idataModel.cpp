@@ -1,8 +1,15 @@
 #include "cvrp_idataModel.h"
+#include "cvrp_modelView.h"
 
 namespace cvrp
 {
 
 IDataModel::~IDataModel() {}
 
-}//cvrp namespace
\ No newline at end of file
+const ModelView& IDataModel::view() const
+{
+    std::call_once(m_snapshotOnce, [this] { m_snapshot.reset(new ModelView(*this)); });
+    return *m_snapshot;
+}
+
+}//cvrp namespace
@@ -1,20 +1,23 @@
 #ifndef CVRP_I_DATA_MODEL
 #define CVRP_I_DATA_MODEL
 
-#include <map>
 #include <vector>
 #include <sstream>
+#include <memory>
+#include <mutex>
 
 namespace cvrp
 {
 typedef std::pair<unsigned int, unsigned int> Coord;
-struct Client
-{
-    Coord position;
-    int demand;
-};
 
-typedef std::map<int, Client> Clients;
+#ifdef CVRP_ROUNDED_DISTANCES
+/* CVRPLIB convention: every edge is rounded to the nearest integer and costs are summed exactly */
+typedef long Cost;
+#else
+typedef double Cost;
+#endif
+
+class ModelView;
 
 class IDataModel
 {
@@ -25,10 +28,17 @@ class IDataModel
         virtual int vehicleCapacity() const = 0;
         virtual const Coord& depot() const = 0;
         virtual int getClientDemand(int clientId) const = 0;
-        virtual const Coord& getClientLocation(int clientId) const = 0;
+        virtual Coord getClientLocation(int clientId) const = 0;
         virtual int numberOfClients() const = 0;
         virtual std::vector<int> getClients() const = 0;
         virtual double getClientDistanceFromDepot(int clientId) const = 0;
+
+        /* Devirtualised view for the solver, by default a snapshot taken on first use */
+        virtual const ModelView& view() const;
+
+    private:
+        mutable std::unique_ptr<ModelView> m_snapshot;
+        mutable std::once_flag m_snapshotOnce;
 };
 
 }//cvrp namespace
@@ -0,0 +1,117 @@
+#include "cvrp_inputFile.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace cvrp
+{
+
+std::shared_ptr<const InputFile> InputFile::open(const std::string& path)
+{
+    if (path == "-")
+    {
+        return read(STDIN_FILENO, "<stdin>");
+    }
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw std::runtime_error("Cannot open " + path + ": " + strerror(errno));
+    }
+    struct stat info;
+    if (fstat(fd, &info) < 0)
+    {
+        int error = errno;
+        ::close(fd);
+        throw std::runtime_error("Cannot stat " + path + ": " + strerror(error));
+    }
+    if (!S_ISREG(info.st_mode))
+    {
+        std::shared_ptr<const InputFile> file;
+        try
+        {
+            file = read(fd, path);
+        }
+        catch (...)
+        {
+            ::close(fd);
+            throw;
+        }
+        ::close(fd);
+        return file;
+    }
+    size_t size = info.st_size;
+    void *data = nullptr;
+    if (size > 0)
+    {
+        data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED)
+        {
+            int error = errno;
+            ::close(fd);
+            throw std::runtime_error("Cannot map " + path + ": " + strerror(error));
+        }
+    }
+    ::close(fd);
+    return std::shared_ptr<const InputFile>(new InputFile(path, static_cast<const char *>(data), size));
+}
+
+std::shared_ptr<const InputFile> InputFile::read(int fd, const std::string& name)
+{
+    std::string buffer;
+    size_t size = 0;
+    for (;;)
+    {
+        if (buffer.size() - size < 64 * 1024)
+        {
+            buffer.resize(std::max<size_t>(buffer.size() * 2, 1 << 20));
+        }
+        const ssize_t count = ::read(fd, &buffer[size], buffer.size() - size);
+        if (count == 0)
+        {
+            break;
+        }
+        if (count < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw std::runtime_error("Cannot read " + name + ": " + strerror(errno));
+        }
+        size += count;
+    }
+    buffer.resize(size);
+    buffer.shrink_to_fit();
+    return std::shared_ptr<const InputFile>(new InputFile(name, std::move(buffer)));
+}
+
+InputFile::InputFile(const std::string& path, std::string&& buffer) :
+    m_path(path),
+    m_buffer(std::move(buffer)),
+    m_data(m_buffer.data()),
+    m_size(m_buffer.size())
+{
+}
+
+InputFile::InputFile(const std::string& path, const char *data, size_t size) :
+    m_path(path),
+    m_data(data),
+    m_size(size)
+{
+}
+
+InputFile::~InputFile()
+{
+    if (mapped())
+    {
+        munmap(const_cast<char *>(m_data), m_size);
+    }
+}
+
+}//cvrp namespace
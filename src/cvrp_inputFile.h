@@ -0,0 +1,44 @@
+#ifndef CVRP_INPUT_FILE
+#define CVRP_INPUT_FILE
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace cvrp
+{
+/*
+ * The whole input as one read-only buffer, handed to the readers without
+ * further copies.  Regular files are memory mapped; stdin ("-"), pipes and
+ * other streams are read once into an owned buffer.  Models loaded from a
+ * binary instance point straight into it and share ownership of it.
+ */
+class InputFile
+{
+    public:
+        static std::shared_ptr<const InputFile> open(const std::string& path);
+        /* Reads fd to its end, the caller keeps ownership of fd */
+        static std::shared_ptr<const InputFile> read(int fd, const std::string& name);
+        ~InputFile();
+
+        InputFile(const InputFile&) = delete;
+        InputFile& operator = (const InputFile&) = delete;
+
+        const char *data() const { return m_data; }
+        size_t size() const { return m_size; }
+        const std::string& path() const { return m_path; }
+        std::string_view text() const { return std::string_view(m_data, m_size); }
+        bool mapped() const { return m_buffer.empty() && m_size > 0; }
+
+    private:
+        InputFile(const std::string& path, const char *data, size_t size);
+        InputFile(const std::string& path, std::string&& buffer);
+
+        std::string m_path;
+        std::string m_buffer;
+        const char *m_data;
+        size_t m_size;
+};
+
+}//cvrp namespace
+#endif
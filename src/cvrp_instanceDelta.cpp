@@ -0,0 +1,100 @@
+#include "cvrp_instanceDelta.h"
+
+#include <sstream>
+#include <stdexcept>
+#include "cvrp_modelView.h"
+
+namespace cvrp
+{
+
+namespace
+{
+void checkData(const ClientChange& client)
+{
+    if (client.x < 0 || client.y < 0 || client.demand < 0)
+    {
+        std::stringstream error;
+        error << "Invalid data for client " << client.id << " in instance delta";
+        throw std::invalid_argument(error.str());
+    }
+}
+}
+
+std::unique_ptr<DataModel> InstanceDelta::apply(const IDataModel& base, const DataModelOptions& options,
+        std::vector<int>& newIds) const
+{
+    const ModelView& view = base.view();
+    const int clients = view.numberOfClients();
+    /* 0 kept, 1 removed, 2 modified: each client can be named once */
+    std::vector<char> edit(clients + 1, 0);
+    const auto mark = [&](int clientId, char kind)
+    {
+        if (clientId < 1 || clientId > clients || edit[clientId])
+        {
+            std::stringstream error;
+            error << "Invalid or repeated client ID in instance delta: " << clientId;
+            throw std::invalid_argument(error.str());
+        }
+        edit[clientId] = kind;
+    };
+    for (int clientId : removed)
+    {
+        mark(clientId, 1);
+    }
+    for (const auto& client : modified)
+    {
+        mark(client.id, 2);
+        checkData(client);
+    }
+
+    InstanceData data;
+    data.vehicleCapacity = view.vehicleCapacity();
+    const size_t size = clients + 1 - removed.size() + added.size();
+    data.xs.reserve(size);
+    data.ys.reserve(size);
+    data.demands.reserve(size);
+    newIds.assign(clients + 1, 0);
+    for (int node = 0; node <= clients; node++)
+    {
+        if (node > 0 && edit[node] == 1)
+        {
+            continue;
+        }
+        newIds[node] = data.xs.size();
+        data.xs.push_back(view.x(node));
+        data.ys.push_back(view.y(node));
+        data.demands.push_back(view.demand(node));
+    }
+    for (const auto& client : modified)
+    {
+        const int newId = newIds[client.id];
+        data.xs[newId] = client.x;
+        data.ys[newId] = client.y;
+        data.demands[newId] = client.demand;
+    }
+    for (const auto& client : added)
+    {
+        checkData(client);
+        data.xs.push_back(client.x);
+        data.ys.push_back(client.y);
+        data.demands.push_back(client.demand);
+    }
+    return std::unique_ptr<DataModel>(new DataModel(std::move(data), options));
+}
+
+std::vector<int> InstanceDelta::changedClients(const std::vector<int>& newIds) const
+{
+    std::vector<int> changed;
+    for (const auto& client : modified)
+    {
+        changed.push_back(newIds[client.id]);
+    }
+    const int kept = newIds.size() - 1 - removed.size();
+    for (size_t i = 0; i < added.size(); i++)
+    {
+        changed.push_back(kept + 1 + i);
+    }
+    return changed;
+}
+
+}//cvrp namespace
@@ -0,0 +1,40 @@
+#ifndef CVRP_INSTANCE_DELTA
+#define CVRP_INSTANCE_DELTA
+
+#include <memory>
+#include <vector>
+#include "cvrp_dataModel.h"
+
+namespace cvrp
+{
+struct ClientChange
+{
+    int id = 0;
+    int x = 0;
+    int y = 0;
+    int demand = 0;
+};
+
+/*
+ * Edits to an instance between two solves.  Applying it gives a new model
+ * in which the kept clients are renumbered 1.. in their old order and the
+ * added ones follow, and the map from old IDs to new ones, which
+ * SolutionFinder::repair uses to carry a previous solution over.
+ */
+struct InstanceDelta
+{
+    /* Their id is ignored, they get the IDs after the kept clients in this order */
+    std::vector<ClientChange> added;
+    std::vector<int> removed;
+    /* New location and demand of existing clients, by their old ID */
+    std::vector<ClientChange> modified;
+
+    /* newIds[old ID] is the client's ID in the new model, 0 for removed ones (and the depot) */
+    std::unique_ptr<DataModel> apply(const IDataModel& base, const DataModelOptions& options,
+            std::vector<int>& newIds) const;
+    /* New IDs of the clients whose data is new: the modified and the added ones */
+    std::vector<int> changedClients(const std::vector<int>& newIds) const;
+};
+
+}//cvrp namespace
+#endif
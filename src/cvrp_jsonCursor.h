@@ -0,0 +1,271 @@
+#ifndef CVRP_JSON_CURSOR
+#define CVRP_JSON_CURSOR
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include "cvrp_textCursor.h"
+
+namespace cvrp
+{
+/* JSON values off a TextCursor */
+class JsonCursor : public TextCursor
+{
+    public:
+        JsonCursor(std::string_view text, const std::string& name) : TextCursor(text, name) {}
+
+        /* What integer() returns for null and for numbers it cannot represent */
+        static constexpr long missing = -1;
+
+        /* Whitespace, // line comments and block comments */
+        void skipSpace()
+        {
+            while (!atEnd())
+            {
+                const char c = *m_pos;
+                if (c == ' ' || c == '\t' || c == '\r' || c == '\n')
+                {
+                    advance();
+                }
+                else if (c == '/' && m_end - m_pos > 1 && m_pos[1] == '/')
+                {
+                    nextLine();
+                }
+                else if (c == '/' && m_end - m_pos > 1 && m_pos[1] == '*')
+                {
+                    m_pos += 2;
+                    while (!atEnd() && !(*m_pos == '*' && m_end - m_pos > 1 && m_pos[1] == '/'))
+                    {
+                        advance();
+                    }
+                    if (atEnd())
+                    {
+                        fail("unterminated comment");
+                    }
+                    m_pos += 2;
+                }
+                else
+                {
+                    return;
+                }
+            }
+        }
+
+        char peek()
+        {
+            skipSpace();
+            return atEnd() ? '\0' : *m_pos;
+        }
+
+        bool consume(char c)
+        {
+            if (peek() != c)
+            {
+                return false;
+            }
+            m_pos++;
+            return true;
+        }
+
+        void expect(char c)
+        {
+            if (!consume(c))
+            {
+                fail(std::string("expected '") + c + "'");
+            }
+        }
+
+        /* The raw contents of a string, escapes left as they are */
+        std::string_view string()
+        {
+            expect('"');
+            const char *start = m_pos;
+            while (!atEnd() && *m_pos != '"')
+            {
+                if (*m_pos == '\\' && m_end - m_pos > 1)
+                {
+                    m_pos++;
+                }
+                advance();
+            }
+            if (atEnd())
+            {
+                fail("unterminated string");
+            }
+            return std::string_view(start, m_pos++ - start);
+        }
+
+        /* A string with its escapes decoded; \\u escapes are limited to ASCII */
+        std::string text()
+        {
+            const std::string_view raw = string();
+            std::string decoded;
+            decoded.reserve(raw.size());
+            for (size_t i = 0; i < raw.size(); i++)
+            {
+                if (raw[i] != '\\')
+                {
+                    decoded += raw[i];
+                    continue;
+                }
+                switch (raw[++i])
+                {
+                case 'n': decoded += '\n'; break;
+                case 't': decoded += '\t'; break;
+                case 'r': decoded += '\r'; break;
+                case 'b': decoded += '\b'; break;
+                case 'f': decoded += '\f'; break;
+                case 'u':
+                {
+                    const std::string hex(raw.substr(i + 1, 4));
+                    char *end = nullptr;
+                    const long code = strtol(hex.c_str(), &end, 16);
+                    if (hex.size() != 4 || end != hex.c_str() + 4 || code > 0x7f)
+                    {
+                        fail("unsupported \\u escape");
+                    }
+                    decoded += char(code);
+                    i += 4;
+                    break;
+                }
+                default: decoded += raw[i]; break;
+                }
+            }
+            return decoded;
+        }
+
+        /* An integral number, or missing for null and numbers out of int range or with a fraction */
+        long integer()
+        {
+            if (peek() == 'n')
+            {
+                literal("null");
+                return missing;
+            }
+            const char *start = m_pos;
+            bool plain = true;
+            while (!atEnd() && ((*m_pos >= '0' && *m_pos <= '9') || *m_pos == '-' || *m_pos == '+' ||
+                        *m_pos == '.' || *m_pos == 'e' || *m_pos == 'E'))
+            {
+                plain = plain && ((*m_pos >= '0' && *m_pos <= '9') || (*m_pos == '-' && m_pos == start));
+                m_pos++;
+            }
+            if (m_pos == start || (m_pos - start == 1 && *start == '-'))
+            {
+                fail("expected a number");
+            }
+            if (plain && m_pos - start < 11)
+            {
+                long value = 0;
+                for (const char *digit = start + (*start == '-'); digit < m_pos; digit++)
+                {
+                    value = value * 10 + (*digit - '0');
+                }
+                value = *start == '-' ? -value : value;
+                return value >= INT_MIN && value <= INT_MAX ? value : missing;
+            }
+            const std::string token(start, m_pos);
+            char *end = nullptr;
+            const double value = strtod(token.c_str(), &end);
+            if (end != token.c_str() + token.size())
+            {
+                fail("malformed number " + token);
+            }
+            return value == std::floor(value) && value >= INT_MIN && value <= INT_MAX ? long(value) : missing;
+        }
+
+        /* Any number as a double; null is NaN */
+        double number()
+        {
+            if (peek() == 'n')
+            {
+                literal("null");
+                return NAN;
+            }
+            const char *start = m_pos;
+            while (!atEnd() && ((*m_pos >= '0' && *m_pos <= '9') || *m_pos == '-' || *m_pos == '+' ||
+                        *m_pos == '.' || *m_pos == 'e' || *m_pos == 'E'))
+            {
+                m_pos++;
+            }
+            const std::string token(start, m_pos);
+            char *end = nullptr;
+            const double value = strtod(token.c_str(), &end);
+            if (token.empty() || end != token.c_str() + token.size())
+            {
+                fail("expected a number");
+            }
+            return value;
+        }
+
+        /* The text of the next value, whatever its type, e.g. to hand a nested object on */
+        std::string_view value()
+        {
+            peek();
+            const char *start = m_pos;
+            skipValue();
+            return std::string_view(start, m_pos - start);
+        }
+
+        void skipValue()
+        {
+            switch (peek())
+            {
+            case '{':
+                m_pos++;
+                if (!consume('}'))
+                {
+                    do
+                    {
+                        string();
+                        expect(':');
+                        skipValue();
+                    } while (consume(','));
+                    expect('}');
+                }
+                break;
+            case '[':
+                m_pos++;
+                if (!consume(']'))
+                {
+                    do
+                    {
+                        skipValue();
+                    } while (consume(','));
+                    expect(']');
+                }
+                break;
+            case '"':
+                string();
+                break;
+            case 't':
+                literal("true");
+                break;
+            case 'f':
+                literal("false");
+                break;
+            case 'n':
+                literal("null");
+                break;
+            default:
+                integer();
+                break;
+            }
+        }
+
+    private:
+        void literal(std::string_view word)
+        {
+            if (std::string_view(m_pos, std::min<size_t>(word.size(), m_end - m_pos)) != word)
+            {
+                fail("unexpected character");
+            }
+            m_pos += word.size();
+        }
+};
+
+}//cvrp namespace
+#endif
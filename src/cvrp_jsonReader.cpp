@@ -0,0 +1,128 @@
+#include "cvrp_jsonReader.h"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include "cvrp_jsonCursor.h"
+
+namespace cvrp
+{
+
+namespace
+{
+constexpr long missing = JsonCursor::missing;
+
+/* Reads the listed integer members of an object, others are skipped; absent ones stay missing */
+template <size_t N>
+void readObject(JsonCursor& cursor, const std::string_view (&keys)[N], long (&values)[N])
+{
+    std::fill(values, values + N, missing);
+    cursor.expect('{');
+    if (cursor.consume('}'))
+    {
+        return;
+    }
+    do
+    {
+        const std::string_view key = cursor.string();
+        cursor.expect(':');
+        size_t i = 0;
+        while (i < N && keys[i] != key)
+        {
+            i++;
+        }
+        if (i < N)
+        {
+            values[i] = cursor.integer();
+        }
+        else
+        {
+            cursor.skipValue();
+        }
+    } while (cursor.consume(','));
+    cursor.expect('}');
+}
+}
+
+InstanceData JsonReader::parse(std::string_view text, const std::string& name)
+{
+    JsonCursor cursor(text, name);
+    InstanceData data;
+    long capacity = missing;
+    long depot[2] = { missing, missing };
+    static const std::string_view depotKeys[2] = { "x", "y" };
+    static const std::string_view clientKeys[3] = { "x", "y", "demand" };
+    /* Index 0 is kept for the depot, which may come after the nodes */
+    data.xs.assign(1, 0);
+    data.ys.assign(1, 0);
+    data.demands.assign(1, 0);
+
+    cursor.expect('{');
+    if (!cursor.consume('}'))
+    {
+        do
+        {
+            const std::string_view key = cursor.string();
+            cursor.expect(':');
+            if (key == "vehicleCapacity")
+            {
+                capacity = cursor.integer();
+            }
+            else if (key == "depot")
+            {
+                readObject(cursor, depotKeys, depot);
+            }
+            else if (key == "nodes")
+            {
+                data.xs.resize(1);
+                data.ys.resize(1);
+                data.demands.resize(1);
+                cursor.expect('[');
+                if (!cursor.consume(']'))
+                {
+                    do
+                    {
+                        long client[3];
+                        readObject(cursor, clientKeys, client);
+                        if (client[0] < 0 || client[1] < 0 || client[2] < 0)
+                        {
+                            std::stringstream error;
+                            error << "Invalid Data OR error parsing json for client: " << data.xs.size();
+                            cursor.fail(error.str());
+                        }
+                        data.xs.push_back(client[0]);
+                        data.ys.push_back(client[1]);
+                        data.demands.push_back(client[2]);
+                    } while (cursor.consume(','));
+                    cursor.expect(']');
+                }
+            }
+            else
+            {
+                cursor.skipValue();
+            }
+        } while (cursor.consume(','));
+        cursor.expect('}');
+    }
+    if (cursor.peek() != '\0')
+    {
+        cursor.fail("unexpected data after the instance");
+    }
+
+    if (capacity < 0)
+    {
+        std::stringstream error;
+        error << "Invalid Vehicle Capacity: " << capacity;
+        throw std::invalid_argument(error.str());
+    }
+    if (depot[0] < 0 || depot[1] < 0)
+    {
+        throw std::invalid_argument("Invalid Data OR error parsing json for 'depot'");
+    }
+    data.vehicleCapacity = capacity;
+    data.xs[0] = depot[0];
+    data.ys[0] = depot[1];
+    return data;
+}
+
+}//cvrp namespace
@@ -0,0 +1,23 @@
+#ifndef CVRP_JSON_READER
+#define CVRP_JSON_READER
+
+#include <string>
+#include <string_view>
+#include "cvrp_dataModel.h"
+
+namespace cvrp
+{
+/*
+ * Single pass reader for the JSON instance format of data/data.json,
+ * straight into InstanceData without building a document tree.  Accepts
+ * // and block comments as that file uses them; unknown keys are skipped.
+ * Missing or negative values are rejected as invalid_argument.
+ */
+class JsonReader
+{
+    public:
+        static InstanceData parse(std::string_view text, const std::string& name);
+};
+
+}//cvrp namespace
+#endif
@@ -0,0 +1,34 @@
+#include "cvrp_lazyDataModel.h"
+
+namespace cvrp
+{
+
+LazyDataModel::LazyDataModel(const DataModel& base, size_t cacheBytes) :
+    m_base(base),
+    m_cache(base.clientXs(), base.clientYs(), cacheBytes),
+    m_distances(attached(m_cache, base.clientXs().size())),
+    m_view(base.clientXs(), base.clientYs(), base.clientDemands(), m_distances, base.vehicleCapacity(), base.neighbourLists())
+{
+}
+
+DistanceMatrix LazyDataModel::attached(const DistanceRowCache& cache, size_t size)
+{
+    DistanceMatrix distances;
+    distances.attach(cache, size);
+    return distances;
+}
+
+double LazyDataModel::distanceBetweenClients(int client1Id, int client2Id) const
+{
+    m_base.checkClient(client1Id);
+    m_base.checkClient(client2Id);
+    return m_distances(client1Id, client2Id);
+}
+
+double LazyDataModel::getClientDistanceFromDepot(int clientId) const
+{
+    m_base.checkClient(clientId);
+    return m_distances(0, clientId);
+}
+
+}//cvrp namespace
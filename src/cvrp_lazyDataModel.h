@@ -0,0 +1,43 @@
+#ifndef CVRP_LAZY_DATA_MODEL
+#define CVRP_LAZY_DATA_MODEL
+
+#include "cvrp_dataModel.h"
+#include "cvrp_distanceRowCache.h"
+
+namespace cvrp
+{
+/*
+ * Serves a DataModel's clients with distances computed a row at a time
+ * and kept in a DistanceRowCache of at most cacheBytes.  Meant for
+ * instances whose matrix does not fit in memory; load the base model
+ * with DistanceStorage::Computed so it does not build one either.
+ */
+class LazyDataModel final : public IDataModel
+{
+    public:
+        LazyDataModel(const DataModel& base, size_t cacheBytes);
+
+        double distanceBetweenClients(int client1Id, int client2Id) const;
+        int vehicleCapacity() const { return m_base.vehicleCapacity(); }
+        const Coord& depot() const { return m_base.depot(); }
+        int getClientDemand(int clientId) const { return m_base.getClientDemand(clientId); }
+        Coord getClientLocation(int clientId) const { return m_base.getClientLocation(clientId); }
+        int numberOfClients() const { return m_base.numberOfClients(); }
+        std::vector<int> getClients() const { return m_base.getClients(); }
+        double getClientDistanceFromDepot(int clientId) const;
+        const ModelView& view() const { return m_view; }
+
+        const DistanceRowCache& cache() const { return m_cache; }
+        const DistanceMatrix& distances() const { return m_distances; }
+
+    private:
+        const DataModel& m_base;
+        DistanceRowCache m_cache;
+        DistanceMatrix m_distances;
+        ModelView m_view;
+
+        static DistanceMatrix attached(const DistanceRowCache& cache, size_t size);
+};
+
+}//cvrp namespace
+#endif
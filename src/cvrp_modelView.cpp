@@ -0,0 +1,51 @@
+#include "cvrp_modelView.h"
+
+#include <algorithm>
+
+namespace cvrp
+{
+
+ModelView::ModelView(const IDataModel& model) :
+    m_vehicleCapacity(model.vehicleCapacity()),
+    m_numberOfClients(model.numberOfClients())
+{
+    std::vector<int> clients = model.getClients();
+    int maxId = clients.empty() ? 0 : *std::max_element(clients.begin(), clients.end());
+
+    size_t size = maxId + 1;
+    m_ownedDemands.assign(size, 0);
+    m_ownedXs.assign(size, model.depot().first);
+    m_ownedYs.assign(size, model.depot().second);
+    for (auto i : clients)
+    {
+        m_ownedDemands[i] = model.getClientDemand(i);
+        m_ownedXs[i] = model.getClientLocation(i).first;
+        m_ownedYs[i] = model.getClientLocation(i).second;
+    }
+    m_ownedDistances.build(size, DistanceStorage::Auto, [&model] (size_t i, size_t j)
+            { return i == 0 ? model.getClientDistanceFromDepot(j) : model.distanceBetweenClients(i, j); });
+    Span<const int> xSpan(m_ownedXs.data(), m_ownedXs.size());
+    Span<const int> ySpan(m_ownedYs.data(), m_ownedYs.size());
+    SpatialGrid grid;
+    grid.build(xSpan, ySpan);
+    m_ownedNeighbours.build(xSpan, ySpan, NeighbourLists::defaultCount, grid);
+    m_xs = m_ownedXs.data();
+    m_ys = m_ownedYs.data();
+    m_demands = m_ownedDemands.data();
+    m_distances = &m_ownedDistances;
+    m_neighbours = &m_ownedNeighbours;
+}
+
+ModelView::ModelView(Span<const int> xs, Span<const int> ys, Span<const int> demands,
+        const DistanceMatrix& distances, int vehicleCapacity, const NeighbourLists& neighbours) :
+    m_xs(xs.data()),
+    m_ys(ys.data()),
+    m_demands(demands.data()),
+    m_distances(&distances),
+    m_neighbours(&neighbours),
+    m_vehicleCapacity(vehicleCapacity),
+    m_numberOfClients(demands.size() - 1)
+{
+}
+
+}//cvrp namespace
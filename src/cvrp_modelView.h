@@ -0,0 +1,56 @@
+#ifndef CVRP_MODEL_VIEW
+#define CVRP_MODEL_VIEW
+
+#include "cvrp_idataModel.h"
+#include "cvrp_util.h"
+#include "cvrp_neighbourLists.h"
+#include "cvrp_distanceMatrix.h"
+
+namespace cvrp
+{
+/*
+ * Concrete, non-virtual view of a model used by the solver's hot path.
+ * Every accessor is an inline array load so that it folds into the
+ * callers in VehicleTrip and SolutionFinder.  Index 0 is the depot.
+ *
+ * Accessors are unchecked: IDs must already have been validated, either
+ * by the model at load time or by SolutionFinder::importSolution.
+ */
+class ModelView final
+{
+    public:
+        /* Snapshot any model through its (virtual) public API */
+        ModelView(const IDataModel& model);
+        /* Reference arrays owned by someone else */
+        ModelView(Span<const int> xs, Span<const int> ys, Span<const int> demands,
+                const DistanceMatrix& distances, int vehicleCapacity, const NeighbourLists& neighbours);
+
+        ModelView(const ModelView&) = delete;
+        ModelView& operator = (const ModelView&) = delete;
+
+        Cost distance(int fromId, int toId) const { return (*m_distances)(fromId, toId); }
+        int demand(int clientId) const { return m_demands[clientId]; }
+        int x(int clientId) const { return m_xs[clientId]; }
+        int y(int clientId) const { return m_ys[clientId]; }
+        int vehicleCapacity() const { return m_vehicleCapacity; }
+        int numberOfClients() const { return m_numberOfClients; }
+        /* Nearest clients first, see NeighbourLists */
+        Span<const int> neighbours(int clientId) const { return m_neighbours->of(clientId); }
+
+    private:
+        AlignedVector<int> m_ownedXs;
+        AlignedVector<int> m_ownedYs;
+        AlignedVector<int> m_ownedDemands;
+        DistanceMatrix m_ownedDistances;
+        NeighbourLists m_ownedNeighbours;
+        const int *m_xs;
+        const int *m_ys;
+        const int *m_demands;
+        const DistanceMatrix *m_distances;
+        const NeighbourLists *m_neighbours;
+        int m_vehicleCapacity;
+        int m_numberOfClients;
+};
+
+}//cvrp namespace
+#endif
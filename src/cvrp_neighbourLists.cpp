@@ -0,0 +1,41 @@
+#include "cvrp_neighbourLists.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace cvrp
+{
+
+void NeighbourLists::build(Span<const int> xs, Span<const int> ys, int count, const SpatialGrid& grid)
+{
+    const long n = xs.size();
+    m_count = effectiveCount(count, n);
+    m_lists.assign(n * m_count, 0);
+    m_data = m_lists.data();
+    m_size = m_lists.size();
+    if (m_count == 0)
+    {
+        return;
+    }
+
+    #pragma omp parallel
+    {
+        std::vector<int> nearest;
+#pragma omp for schedule(dynamic, 256)
+        for (long i = 0; i < n; i++)
+        {
+            grid.nearest(xs[i], ys[i], m_count, nearest, i);
+            std::copy(nearest.begin(), nearest.end(), m_lists.begin() + i * m_count);
+        }
+    }
+}
+
+void NeighbourLists::adopt(Span<const int> lists, int count)
+{
+    m_lists.clear();
+    m_data = lists.data();
+    m_size = lists.size();
+    m_count = count;
+}
+
+}//cvrp namespace
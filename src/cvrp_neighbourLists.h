@@ -0,0 +1,42 @@
+#ifndef CVRP_NEIGHBOUR_LISTS
+#define CVRP_NEIGHBOUR_LISTS
+
+#include <algorithm>
+#include "cvrp_util.h"
+#include "cvrp_spatialGrid.h"
+
+namespace cvrp
+{
+/*
+ * For every client (and the depot, at index 0) the IDs of its K nearest
+ * clients, nearest first.  The depot never appears in a list.  Stored as
+ * one flat row-major array so that a candidate scan is a single stream.
+ */
+class NeighbourLists
+{
+    public:
+        static constexpr int defaultCount = 16;
+
+        NeighbourLists() : m_data(nullptr), m_size(0), m_count(0) {}
+
+        void build(Span<const int> xs, Span<const int> ys, int count, const SpatialGrid& grid);
+        /* Use lists stored elsewhere, e.g. in a mapped binary instance */
+        void adopt(Span<const int> lists, int count);
+
+        /* List length actually built for a requested count over size nodes */
+        static int effectiveCount(int count, size_t size) { return std::max(0, std::min<int>(count, (long) size - 2)); }
+
+        int count() const { return m_count; }
+        Span<const int> of(int clientId) const
+            { return Span<const int>(m_data + clientId * m_count, m_count); }
+        Span<const int> all() const { return Span<const int>(m_data, m_size); }
+
+    private:
+        AlignedVector<int> m_lists;
+        const int *m_data;
+        size_t m_size;
+        int m_count;
+};
+
+}//cvrp namespace
+#endif
@@ -0,0 +1,110 @@
+#include "cvrp_routeMoves.h"
+
+namespace cvrp
+{
+
+namespace
+{
+MoveEvaluation evaluate(const VehicleTrip& a, std::initializer_list<RouteSegment> newA,
+        const VehicleTrip& b, std::initializer_list<RouteSegment> newB)
+{
+    const ModelView& model = a.model();
+    int loadA = 0;
+    for (const auto& segment : newA)
+    {
+        loadA += segment.load;
+    }
+    int loadB = 0;
+    for (const auto& segment : newB)
+    {
+        loadB += segment.load;
+    }
+    const Cost delta = RouteMoves::concatenate(model, newA) + RouteMoves::concatenate(model, newB) - a.cost() - b.cost();
+    const uint64_t hash = RouteMoves::concatenatedHash(newA) ^ RouteMoves::concatenatedHash(newB) ^ a.hash() ^ b.hash();
+    return MoveEvaluation{ delta, loadA <= model.vehicleCapacity() && loadB <= model.vehicleCapacity(), hash };
+}
+}
+
+Cost RouteMoves::concatenate(const ModelView& model, std::initializer_list<RouteSegment> segments)
+{
+    Cost cost = 0;
+    int previous = 0;
+    for (const auto& segment : segments)
+    {
+        if (!segment.empty())
+        {
+            cost += model.distance(previous, segment.first) + segment.distance;
+            previous = segment.last;
+        }
+    }
+    return cost + model.distance(previous, 0);
+}
+
+uint64_t RouteMoves::concatenatedHash(std::initializer_list<RouteSegment> segments)
+{
+    uint64_t hash = 0;
+    int previous = 0;
+    for (const auto& segment : segments)
+    {
+        if (!segment.empty())
+        {
+            hash ^= VehicleTrip::edgeKey(segment.first, previous) ^ segment.hash;
+            previous = segment.last;
+        }
+    }
+    return previous == 0 ? 0 : hash ^ VehicleTrip::edgeKey(0, previous);
+}
+
+MoveEvaluation RouteMoves::relocate(const VehicleTrip& from, size_t position, const VehicleTrip& to, size_t insertion)
+{
+    return crossExchange(from, position, 1, to, insertion, 0);
+}
+
+MoveEvaluation RouteMoves::swap(const VehicleTrip& a, size_t i, const VehicleTrip& b, size_t j)
+{
+    return crossExchange(a, i, 1, b, j, 1);
+}
+
+MoveEvaluation RouteMoves::twoOptStar(const VehicleTrip& a, size_t i, const VehicleTrip& b, size_t j)
+{
+    const size_t sizeA = a.getSeqSize();
+    const size_t sizeB = b.getSeqSize();
+    return evaluate(a, { a.segment(0, i), b.segment(j, sizeB) }, b, { b.segment(0, j), a.segment(i, sizeA) });
+}
+
+MoveEvaluation RouteMoves::crossExchange(const VehicleTrip& a, size_t i, size_t lengthA,
+        const VehicleTrip& b, size_t j, size_t lengthB)
+{
+    const size_t sizeA = a.getSeqSize();
+    const size_t sizeB = b.getSeqSize();
+    return evaluate(a, { a.segment(0, i), b.segment(j, j + lengthB), a.segment(i + lengthA, sizeA) },
+            b, { b.segment(0, j), a.segment(i, i + lengthA), b.segment(j + lengthB, sizeB) });
+}
+
+void RouteMoves::applyCrossExchange(VehicleTrip& a, size_t i, size_t lengthA, VehicleTrip& b, size_t j, size_t lengthB)
+{
+    auto& sequenceA = a.clientSequence();
+    auto& sequenceB = b.clientSequence();
+    const std::vector<int> fromA(sequenceA.begin() + i, sequenceA.begin() + i + lengthA);
+    sequenceA.erase(sequenceA.begin() + i, sequenceA.begin() + i + lengthA);
+    sequenceA.insert(sequenceA.begin() + i, sequenceB.begin() + j, sequenceB.begin() + j + lengthB);
+    sequenceB.erase(sequenceB.begin() + j, sequenceB.begin() + j + lengthB);
+    sequenceB.insert(sequenceB.begin() + j, fromA.begin(), fromA.end());
+    a.reEvaluateInOrder();
+    b.reEvaluateInOrder();
+}
+
+void RouteMoves::applyTwoOptStar(VehicleTrip& a, size_t i, VehicleTrip& b, size_t j)
+{
+    auto& sequenceA = a.clientSequence();
+    auto& sequenceB = b.clientSequence();
+    const std::vector<int> tailA(sequenceA.begin() + i, sequenceA.end());
+    sequenceA.resize(i);
+    sequenceA.insert(sequenceA.end(), sequenceB.begin() + j, sequenceB.end());
+    sequenceB.resize(j);
+    sequenceB.insert(sequenceB.end(), tailA.begin(), tailA.end());
+    a.reEvaluateInOrder();
+    b.reEvaluateInOrder();
+}
+
+}//cvrp namespace
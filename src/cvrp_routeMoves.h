@@ -0,0 +1,49 @@
+#ifndef CVRP_ROUTE_MOVES
+#define CVRP_ROUTE_MOVES
+
+#include <initializer_list>
+#include "cvrp_vehicleTrip.h"
+
+namespace cvrp
+{
+/* What a move would do to the two trips it involves */
+struct MoveEvaluation
+{
+    /* New cost of both trips minus their current cost */
+    Cost delta;
+    /* Both trips within the vehicle capacity afterwards */
+    bool feasible;
+    /* XOR this into the solution's hash to get the moved solution's */
+    uint64_t hash;
+};
+
+/*
+ * Inter-route moves between two distinct trips, priced in O(1) from the
+ * trips' segments before anything is changed.  Each trip keeps its order
+ * apart from the exchanged part; positions index clientSeqConst().
+ */
+class RouteMoves
+{
+    public:
+        /* Cost of the segments visited in order from the depot and back */
+        static Cost concatenate(const ModelView& model, std::initializer_list<RouteSegment> segments);
+        /* Hash of the trip the segments make up, see VehicleTrip::hash */
+        static uint64_t concatenatedHash(std::initializer_list<RouteSegment> segments);
+
+        /* The client at position of from goes before insertion of to */
+        static MoveEvaluation relocate(const VehicleTrip& from, size_t position, const VehicleTrip& to, size_t insertion);
+        /* Client i of a and client j of b trade places */
+        static MoveEvaluation swap(const VehicleTrip& a, size_t i, const VehicleTrip& b, size_t j);
+        /* a keeps [0, i) then takes b from j on, b keeps [0, j) then takes a from i on */
+        static MoveEvaluation twoOptStar(const VehicleTrip& a, size_t i, const VehicleTrip& b, size_t j);
+        /* a[i, i + lengthA) and b[j, j + lengthB) trade places, either length possibly zero */
+        static MoveEvaluation crossExchange(const VehicleTrip& a, size_t i, size_t lengthA,
+                const VehicleTrip& b, size_t j, size_t lengthB);
+
+        /* Performs a cross-exchange as evaluated and re-evaluates both trips in their new order */
+        static void applyCrossExchange(VehicleTrip& a, size_t i, size_t lengthA, VehicleTrip& b, size_t j, size_t lengthB);
+        static void applyTwoOptStar(VehicleTrip& a, size_t i, VehicleTrip& b, size_t j);
+};
+
+}//cvrp namespace
+#endif
@@ -0,0 +1,176 @@
+#include "cvrp_routeSearch.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace cvrp
+{
+
+namespace
+{
+constexpr size_t maxSegment = 3;
+
+/* Gains below this are rounding noise, taking them could cycle */
+#ifdef CVRP_ROUNDED_DISTANCES
+bool improves(Cost gain) { return gain > 0; }
+#else
+bool improves(Cost gain) { return gain > 1e-9; }
+#endif
+
+/* Node k of the closed route: the depot at 0 and size + 1, the clients in between */
+inline int node(const ClientSequence& route, size_t k)
+{
+    return k == 0 || k > route.size() ? 0 : route[k - 1];
+}
+}
+
+RouteOptimiser RouteSearch::parse(const std::string& name)
+{
+    if (name == "greedy")
+    {
+        return RouteOptimiser::Greedy;
+    }
+    if (name == "2opt")
+    {
+        return RouteOptimiser::TwoOpt;
+    }
+    if (name == "local")
+    {
+        return RouteOptimiser::LocalSearch;
+    }
+    throw std::invalid_argument("Unknown route optimiser: " + name);
+}
+
+const char *RouteSearch::name(RouteOptimiser optimiser)
+{
+    switch (optimiser)
+    {
+    case RouteOptimiser::TwoOpt:
+        return "2opt";
+    case RouteOptimiser::LocalSearch:
+        return "local";
+    default:
+        return "greedy";
+    }
+}
+
+Cost RouteSearch::improve(ClientSequence& route, const ModelView& model, RouteOptimiser optimiser, Cost cost)
+{
+    switch (optimiser)
+    {
+    case RouteOptimiser::Greedy:
+        break;
+    case RouteOptimiser::TwoOpt:
+        cost = twoOpt(route, model, cost);
+        break;
+    case RouteOptimiser::LocalSearch:
+        /* Or-opt can open new 2-opt moves and the other way round */
+        for (;;)
+        {
+            const Cost before = cost;
+            cost = orOpt(route, model, twoOpt(route, model, cost));
+            if (!improves(before - cost))
+            {
+                break;
+            }
+        }
+        break;
+    }
+    return cost;
+}
+
+Cost RouteSearch::twoOpt(ClientSequence& route, const ModelView& model, Cost cost)
+{
+    const size_t size = route.size();
+    bool improved = true;
+    while (improved)
+    {
+        improved = false;
+        /* Edges (i, i + 1) and (j, j + 1) become (i, j) and (i + 1, j + 1) */
+        for (size_t i = 0; i + 2 <= size; i++)
+        {
+            const int a = node(route, i);
+            const int b = node(route, i + 1);
+            const Cost ab = model.distance(a, b);
+            for (size_t j = i + 2; j <= size; j++)
+            {
+                const int c = node(route, j);
+                const int d = node(route, j + 1);
+                const Cost gain = ab + model.distance(c, d) - model.distance(a, c) - model.distance(b, d);
+                if (improves(gain))
+                {
+                    std::reverse(route.begin() + i, route.begin() + j);
+                    cost -= gain;
+                    improved = true;
+                    break;
+                }
+            }
+            if (improved)
+            {
+                break;
+            }
+        }
+    }
+    return cost;
+}
+
+Cost RouteSearch::orOpt(ClientSequence& route, const ModelView& model, Cost cost)
+{
+    const size_t size = route.size();
+    bool improved = true;
+    while (improved)
+    {
+        improved = false;
+        for (size_t length = 1; length <= std::min(maxSegment, size) && !improved; length++)
+        {
+            /* The segment is nodes start .. start + length - 1, between prev and next */
+            for (size_t start = 1; start + length <= size + 1 && !improved; start++)
+            {
+                const int prev = node(route, start - 1);
+                const int first = node(route, start);
+                const int last = node(route, start + length - 1);
+                const int next = node(route, start + length);
+                const Cost removal = model.distance(prev, first) + model.distance(last, next) - model.distance(prev, next);
+                /* Insert between nodes p and p + 1 of the route without the segment */
+                for (size_t p = 0; p <= size - length; p++)
+                {
+                    if (p == start - 1)
+                    {
+                        continue;
+                    }
+                    const size_t u = p < start ? p : p + length;
+                    const int from = node(route, u);
+                    const int to = node(route, u + 1);
+                    const Cost base = model.distance(from, to);
+                    const Cost forward = model.distance(from, first) + model.distance(last, to) - base;
+                    const Cost backward = model.distance(from, last) + model.distance(first, to) - base;
+                    const bool reversed = backward < forward;
+                    const Cost gain = removal - (reversed ? backward : forward);
+                    if (!improves(gain))
+                    {
+                        continue;
+                    }
+                    const auto segment = route.begin() + (start - 1);
+                    if (reversed)
+                    {
+                        std::reverse(segment, segment + length);
+                    }
+                    if (u < start)
+                    {
+                        std::rotate(route.begin() + u, segment, segment + length);
+                    }
+                    else
+                    {
+                        std::rotate(segment, segment + length, route.begin() + u);
+                    }
+                    cost -= gain;
+                    improved = true;
+                    break;
+                }
+            }
+        }
+    }
+    return cost;
+}
+
+}//cvrp namespace
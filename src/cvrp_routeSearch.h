@@ -0,0 +1,38 @@
+#ifndef CVRP_ROUTE_SEARCH
+#define CVRP_ROUTE_SEARCH
+
+#include <string>
+#include "cvrp_modelView.h"
+
+namespace cvrp
+{
+/* How a trip is ordered once its clients are known */
+enum class RouteOptimiser
+{
+    Greedy,     /* Nearest neighbour from the depot, the long-standing order */
+    TwoOpt,     /* Greedy, then 2-opt to a local optimum */
+    LocalSearch /* Greedy, then 2-opt and Or-opt (relocate included) to a local optimum */
+};
+
+/*
+ * Intra-route local search with delta evaluation: each candidate move is
+ * priced from the few edges it changes, and the first improving one is
+ * applied, until no move improves the route.  The depot closes the route
+ * at both ends.
+ */
+class RouteSearch
+{
+    public:
+        /* greedy, 2opt or local */
+        static RouteOptimiser parse(const std::string& name);
+        static const char *name(RouteOptimiser optimiser);
+
+        /* Improves an already costed route in place and returns its new cost */
+        static Cost improve(ClientSequence& route, const ModelView& model, RouteOptimiser optimiser, Cost cost);
+        static Cost twoOpt(ClientSequence& route, const ModelView& model, Cost cost);
+        /* Moves segments of up to three clients elsewhere in the route, possibly reversed */
+        static Cost orOpt(ClientSequence& route, const ModelView& model, Cost cost);
+};
+
+}//cvrp namespace
+#endif
@@ -0,0 +1,477 @@
+#include "cvrp_server.h"
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <future>
+#include <list>
+#include <stdexcept>
+#include <thread>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "cvrp_inputFile.h"
+#include "cvrp_jsonCursor.h"
+#include "cvrp_jsonReader.h"
+#include "cvrp_solutionReader.h"
+#include "cvrp_solutionWriter.h"
+
+namespace cvrp
+{
+
+namespace
+{
+/* How often blocked reads and accepts look for an interrupt, in milliseconds */
+constexpr int pollInterval = 250;
+
+void appendJsonString(std::string& out, std::string_view text)
+{
+    out += '"';
+    for (const char c : text)
+    {
+        if (c == '"' || c == '\\')
+        {
+            out += '\\';
+            out += c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20)
+        {
+            char escape[8];
+            snprintf(escape, sizeof(escape), "\\u%04x", c);
+            out += escape;
+        }
+        else
+        {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+void writeAll(int fd, std::string_view data)
+{
+    while (!data.empty())
+    {
+        const ssize_t count = ::write(fd, data.data(), data.size());
+        if (count < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw std::runtime_error(std::string("Cannot write a reply: ") + strerror(errno));
+        }
+        data.remove_prefix(count);
+    }
+}
+
+/* Calls reply for every line of in and writes what it returns to out */
+void replyToLines(int in, int out, const std::function<std::string(std::string_view)>& reply)
+{
+    std::string pending;
+    char chunk[1 << 16];
+    for (;;)
+    {
+        pollfd ready = { in, POLLIN, 0 };
+        const int polled = poll(&ready, 1, pollInterval);
+        if (SolutionFinder::interrupted())
+        {
+            return;
+        }
+        if (polled <= 0)
+        {
+            if (polled < 0 && errno != EINTR)
+            {
+                throw std::runtime_error(std::string("Cannot read requests: ") + strerror(errno));
+            }
+            continue;
+        }
+        const ssize_t count = ::read(in, chunk, sizeof(chunk));
+        if (count < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw std::runtime_error(std::string("Cannot read requests: ") + strerror(errno));
+        }
+        pending.append(chunk, count);
+        size_t start = 0;
+        for (size_t end; (end = pending.find('\n', start)) != std::string::npos; start = end + 1)
+        {
+            const std::string_view line(pending.data() + start, end - start);
+            if (line.find_first_not_of(" \t\r") != std::string_view::npos)
+            {
+                writeAll(out, reply(line));
+            }
+        }
+        pending.erase(0, start);
+        if (count == 0)
+        {
+            /* A last request without its newline */
+            if (pending.find_first_not_of(" \t\r") != std::string::npos)
+            {
+                writeAll(out, reply(pending));
+            }
+            return;
+        }
+    }
+}
+}
+
+struct Server::Request
+{
+    std::string id = "null";
+    std::string path;
+    std::string_view inlineInstance;
+    std::string warmStart;
+    EvolutionOptions evolution;
+    RouteOptimiser routes;
+};
+
+Server::Server(const ServerOptions& options) :
+    m_options(options)
+{
+    m_options.evolution.progress = false;
+    m_options.cacheSize = std::max<size_t>(m_options.cacheSize, 1);
+}
+
+std::string Server::handle(std::string_view line)
+{
+    Request request;
+    request.evolution = m_options.evolution;
+    request.routes = m_options.routes;
+    try
+    {
+        static const std::string name = "request";
+        JsonCursor cursor(line, name);
+        cursor.expect('{');
+        if (!cursor.consume('}'))
+        {
+            do
+            {
+                const std::string_view key = cursor.string();
+                cursor.expect(':');
+                if (key == "id")
+                {
+                    request.id = cursor.value();
+                }
+                else if (key == "instance")
+                {
+                    if (cursor.peek() == '{')
+                    {
+                        request.inlineInstance = cursor.value();
+                    }
+                    else
+                    {
+                        request.path = cursor.text();
+                    }
+                }
+                else if (key == "warmStart")
+                {
+                    request.warmStart = cursor.text();
+                }
+                else if (key == "routes")
+                {
+                    request.routes = RouteSearch::parse(cursor.text());
+                }
+                else if (key == "timeLimit")
+                {
+                    const double seconds = cursor.number();
+                    if (!(seconds >= 0))
+                    {
+                        cursor.fail("timeLimit must be a number of seconds");
+                    }
+                    request.evolution.timeLimit = seconds;
+                }
+                else if (key == "seed" || key == "population" || key == "generations" || key == "mutations")
+                {
+                    const double value = cursor.number();
+                    if (!(value >= 0) || value != std::floor(value))
+                    {
+                        cursor.fail(std::string(key) + " must be a non-negative integer");
+                    }
+                    unsigned long& field = key == "seed" ? request.evolution.seed :
+                        key == "population" ? request.evolution.initialPopulation :
+                        key == "generations" ? request.evolution.maxGenerations :
+                        request.evolution.maxMutationsPerGeneration;
+                    field = static_cast<unsigned long>(value);
+                }
+                else
+                {
+                    cursor.skipValue();
+                }
+            } while (cursor.consume(','));
+            cursor.expect('}');
+        }
+        if (cursor.peek() != '\0')
+        {
+            cursor.fail("unexpected data after the request");
+        }
+        if (request.path.empty() && request.inlineInstance.empty())
+        {
+            throw std::invalid_argument("request has no instance");
+        }
+        request.evolution.initialPopulation = std::max(1ul, request.evolution.initialPopulation);
+        request.evolution.maxMutationsPerGeneration = std::max(1ul, request.evolution.maxMutationsPerGeneration);
+        return solve(request);
+    }
+    catch (const std::exception& error)
+    {
+        std::string reply = "{\"id\":" + request.id + ",\"error\":";
+        appendJsonString(reply, error.what());
+        reply += "}\n";
+        return reply;
+    }
+}
+
+std::shared_ptr<const DataModel> Server::instance(const Request& request, bool& cached)
+{
+    std::string key;
+    if (request.inlineInstance.empty())
+    {
+        struct stat info;
+        if (stat(request.path.c_str(), &info) < 0)
+        {
+            throw std::runtime_error("Cannot open " + request.path + ": " + strerror(errno));
+        }
+        key = request.path + '\0' + std::to_string(info.st_size) + '\0' + std::to_string(info.st_mtim.tv_sec) +
+            '.' + std::to_string(info.st_mtim.tv_nsec);
+    }
+    else
+    {
+        key = std::string("\0inline\0", 8) + std::string(request.inlineInstance);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_cacheLock);
+        for (auto it = m_cache.begin(); it != m_cache.end(); ++it)
+        {
+            if (it->first == key)
+            {
+                m_cache.splice(m_cache.begin(), m_cache, it);
+                cached = true;
+                return it->second;
+            }
+        }
+    }
+
+    std::shared_ptr<const DataModel> model;
+    if (request.inlineInstance.empty())
+    {
+        model = DataModel::load(InputFile::open(request.path), m_options.model);
+    }
+    else
+    {
+        model = std::make_shared<DataModel>(JsonReader::parse(request.inlineInstance, "inline instance"), m_options.model);
+    }
+    cached = false;
+
+    std::lock_guard<std::mutex> lock(m_cacheLock);
+    m_cache.emplace_front(std::move(key), model);
+    if (m_cache.size() > m_options.cacheSize)
+    {
+        m_cache.pop_back();
+    }
+    return model;
+}
+
+std::string Server::solve(const Request& request)
+{
+    const auto start = std::chrono::steady_clock::now();
+    bool cached = false;
+    std::shared_ptr<const DataModel> model = instance(request, cached);
+
+    std::string solution;
+    {
+        std::lock_guard<std::mutex> lock(m_solveLock);
+        SolutionFinder finder(*model, request.routes);
+        std::vector<SolutionModel> start;
+        if (!request.warmStart.empty())
+        {
+            for (const auto& routes : SolutionReader::parse(InputFile::open(request.warmStart)->text(), request.warmStart))
+            {
+                start.push_back(finder.warmStart(routes));
+            }
+        }
+        SolutionWriter::render(finder.solutionWithEvolution(request.evolution, start), SolutionFormat::Json, solution);
+    }
+
+    char seconds[32];
+    snprintf(seconds, sizeof(seconds), "%.6f", std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    /* The JSON solution is an object of its own; its members follow the request's */
+    std::string reply = "{\"id\":" + request.id + ",\"seconds\":" + seconds + ",\"cached\":" + (cached ? "true" : "false") + ",";
+    reply.append(solution, 1, std::string::npos);
+    return reply;
+}
+
+void Server::serve(int in, int out)
+{
+    std::signal(SIGPIPE, SIG_IGN);
+    replyToLines(in, out, [this](std::string_view line) { return handle(line); });
+}
+
+void Server::listen(const std::string& socketPath)
+{
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path))
+    {
+        throw std::invalid_argument("Socket path too long: " + socketPath);
+    }
+    memcpy(address.sun_path, socketPath.c_str(), socketPath.size());
+    const int listener = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listener < 0)
+    {
+        throw std::runtime_error(std::string("Cannot create a socket: ") + strerror(errno));
+    }
+    unlink(socketPath.c_str());
+    if (bind(listener, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) < 0 || ::listen(listener, 16) < 0)
+    {
+        const std::string reason = strerror(errno);
+        close(listener);
+        throw std::runtime_error("Cannot listen on " + socketPath + ": " + reason);
+    }
+    std::signal(SIGPIPE, SIG_IGN);
+
+    /*
+     * Connection threads only read requests and write replies; the solves
+     * are queued to this thread, whose OpenMP team then persists across them.
+     */
+    struct Job
+    {
+        std::string line;
+        std::promise<std::string> reply;
+    };
+    std::mutex queueLock;
+    std::condition_variable queued;
+    std::deque<Job *> jobs;
+    std::atomic<int> connections(0);
+    std::atomic_bool stopping(false);
+    /*
+     * Connection threads use the locals above, so each is joined before
+     * they go out of scope.  Only the acceptor touches the list until it ends.
+     */
+    struct Connection
+    {
+        std::thread thread;
+        std::atomic_bool done{false};
+    };
+    std::list<Connection> open;
+
+    std::thread acceptor([&]()
+    {
+        while (!stopping)
+        {
+            for (auto it = open.begin(); it != open.end(); )
+            {
+                if (it->done)
+                {
+                    it->thread.join();
+                    it = open.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+            pollfd ready = { listener, POLLIN, 0 };
+            if (poll(&ready, 1, pollInterval) <= 0)
+            {
+                continue;
+            }
+            const int connection = accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+            if (connection < 0)
+            {
+                continue;
+            }
+            connections++;
+            open.emplace_back();
+            Connection& self = open.back();
+            self.thread = std::thread([&, connection]()
+            {
+                try
+                {
+                    replyToLines(connection, connection, [&](std::string_view line)
+                    {
+                        Job job;
+                        job.line = line;
+                        std::future<std::string> reply = job.reply.get_future();
+                        {
+                            std::lock_guard<std::mutex> lock(queueLock);
+                            jobs.push_back(&job);
+                        }
+                        queued.notify_one();
+                        return reply.get();
+                    });
+                }
+                catch (const std::exception& error)
+                {
+                    fprintf(stderr, "%s\n", error.what());
+                }
+                close(connection);
+                connections--;
+                queued.notify_one();
+                self.done = true;
+            });
+        }
+    });
+
+    while (!SolutionFinder::interrupted())
+    {
+        Job *job = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(queueLock);
+            queued.wait_for(lock, std::chrono::milliseconds(pollInterval), [&]() { return !jobs.empty(); });
+            if (jobs.empty())
+            {
+                continue;
+            }
+            job = jobs.front();
+            jobs.pop_front();
+        }
+        job->reply.set_value(handle(job->line));
+    }
+
+    stopping = true;
+    acceptor.join();
+    /* Connections notice the interrupt within a poll interval; answer whatever they queued meanwhile */
+    std::unique_lock<std::mutex> lock(queueLock);
+    while (connections > 0 || !jobs.empty())
+    {
+        while (!jobs.empty())
+        {
+            Job *job = jobs.front();
+            jobs.pop_front();
+            lock.unlock();
+            job->reply.set_value(handle(job->line));
+            lock.lock();
+        }
+        queued.wait_for(lock, std::chrono::milliseconds(pollInterval));
+    }
+    lock.unlock();
+    for (auto& connection : open)
+    {
+        connection.thread.join();
+    }
+    close(listener);
+    unlink(socketPath.c_str());
+}
+
+size_t Server::cachedInstances() const
+{
+    std::lock_guard<std::mutex> lock(m_cacheLock);
+    return m_cache.size();
+}
+
+}//cvrp namespace
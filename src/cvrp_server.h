@@ -0,0 +1,74 @@
+#ifndef CVRP_SERVER
+#define CVRP_SERVER
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include "cvrp_dataModel.h"
+#include "cvrp_solutionFinder.h"
+
+namespace cvrp
+{
+struct ServerOptions
+{
+    DataModelOptions model;
+    /* Budget of requests that do not set their own */
+    EvolutionOptions evolution;
+    RouteOptimiser routes = RouteOptimiser::Greedy;
+    /* Loaded instances kept for later requests (SERVER_CACHE) */
+    size_t cacheSize = 8;
+};
+
+/*
+ * Long-lived solver speaking JSON lines, one request per line:
+ *
+ *   {"id": 7, "instance": "/data/a.vrp", "timeLimit": 0.5, "seed": 42}
+ *
+ * "instance" is a path (JSON, .vrp or binary) or an inline JSON instance
+ * object; "warmStart" is a file of prior solutions to start from (see
+ * cvrp_solutionReader.h); "timeLimit", "seed", "population",
+ * "generations" and "mutations" override the server's budget, and
+ * "routes" (greedy, 2opt or local) its route optimiser.  Each
+ * request gets one line back, as soon as it is solved, with the id
+ * echoed as sent:
+ *
+ *   {"id":7,"seconds":0.5,"cached":true,"cost":...,"routes":[...]}
+ *   {"id":7,"error":"..."}
+ *
+ * Solves run one at a time, each with the whole OpenMP team, so the team
+ * and the per-thread generators stay warm between requests.  The most
+ * recently used instances stay loaded, paths keyed by size and mtime so
+ * an edited file is reloaded.
+ */
+class Server
+{
+    public:
+        Server(const ServerOptions& options);
+
+        /* One request line in, one reply line out, newline included */
+        std::string handle(std::string_view request);
+        /* Replies to the lines read from in on out, until end of input or an interrupt */
+        void serve(int in, int out);
+        /* Accepts connections on a Unix domain socket, each served on its own thread */
+        void listen(const std::string& socketPath);
+
+        size_t cachedInstances() const;
+
+    private:
+        struct Request;
+
+        ServerOptions m_options;
+        /* One solve at a time; each already uses every thread */
+        std::mutex m_solveLock;
+        mutable std::mutex m_cacheLock;
+        /* Most recently used first */
+        std::list<std::pair<std::string, std::shared_ptr<const DataModel>>> m_cache;
+
+        std::shared_ptr<const DataModel> instance(const Request& request, bool& cached);
+        std::string solve(const Request& request);
+};
+
+}//cvrp namespace
+#endif
@@ -0,0 +1,219 @@
+#ifndef CVRP_SMALL_VECTOR
+#define CVRP_SMALL_VECTOR
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+
+namespace cvrp
+{
+/*
+ * Vector of trivially copyable elements holding up to N of them inline,
+ * so that copying a short one never allocates; longer ones move to the
+ * heap and stay there until shrink_to_fit.  Only the std::vector members
+ * the solver uses are provided.  Ranges inserted must not come from the
+ * vector itself.
+ */
+template <typename T, size_t N>
+class SmallVector
+{
+    static_assert(std::is_trivially_copyable<T>::value, "SmallVector copies its elements with memcpy");
+
+    public:
+        typedef T value_type;
+        typedef T *iterator;
+        typedef const T *const_iterator;
+        typedef size_t size_type;
+
+        SmallVector() : m_data(m_inline), m_size(0), m_capacity(N) {}
+        SmallVector(std::initializer_list<T> values) : SmallVector() { assign(values.begin(), values.end()); }
+        template <typename Iterator>
+        SmallVector(Iterator first, Iterator last) : SmallVector() { assign(first, last); }
+        SmallVector(const SmallVector& other) : SmallVector() { assign(other.begin(), other.end()); }
+        SmallVector(SmallVector&& other) noexcept : SmallVector() { take(other); }
+        ~SmallVector() { release(); }
+
+        SmallVector& operator = (const SmallVector& other)
+        {
+            if (this != &other)
+            {
+                assign(other.begin(), other.end());
+            }
+            return *this;
+        }
+
+        SmallVector& operator = (SmallVector&& other) noexcept
+        {
+            if (this != &other)
+            {
+                release();
+                m_data = m_inline;
+                m_capacity = N;
+                take(other);
+            }
+            return *this;
+        }
+
+        template <typename Iterator>
+        void assign(Iterator first, Iterator last)
+        {
+            const size_t count = std::distance(first, last);
+            m_size = 0;
+            reserve(count);
+            std::copy(first, last, m_data);
+            m_size = count;
+        }
+
+        T *data() { return m_data; }
+        const T *data() const { return m_data; }
+        size_t size() const { return m_size; }
+        size_t capacity() const { return m_capacity; }
+        bool empty() const { return m_size == 0; }
+        /* Whether the elements are in the inline buffer */
+        bool isInline() const { return m_data == m_inline; }
+
+        iterator begin() { return m_data; }
+        iterator end() { return m_data + m_size; }
+        const_iterator begin() const { return m_data; }
+        const_iterator end() const { return m_data + m_size; }
+
+        T& operator [] (size_t i) { return m_data[i]; }
+        const T& operator [] (size_t i) const { return m_data[i]; }
+        T& front() { return m_data[0]; }
+        const T& front() const { return m_data[0]; }
+        T& back() { return m_data[m_size - 1]; }
+        const T& back() const { return m_data[m_size - 1]; }
+
+        void reserve(size_t capacity)
+        {
+            if (capacity > m_capacity)
+            {
+                grow(std::max<size_t>(capacity, 2 * m_capacity));
+            }
+        }
+
+        void resize(size_t size)
+        {
+            reserve(size);
+            if (size > m_size)
+            {
+                std::fill(m_data + m_size, m_data + size, T());
+            }
+            m_size = size;
+        }
+
+        void clear() { m_size = 0; }
+
+        void push_back(const T& value)
+        {
+            if (m_size == m_capacity)
+            {
+                const T copy = value;
+                grow(2 * m_capacity);
+                m_data[m_size++] = copy;
+                return;
+            }
+            m_data[m_size++] = value;
+        }
+
+        void pop_back() { m_size--; }
+
+        template <typename Iterator>
+        iterator insert(const_iterator position, Iterator first, Iterator last)
+        {
+            const size_t offset = position - m_data;
+            const size_t count = std::distance(first, last);
+            reserve(m_size + count);
+            T *at = m_data + offset;
+            memmove(at + count, at, (m_size - offset) * sizeof(T));
+            std::copy(first, last, at);
+            m_size += count;
+            return at;
+        }
+
+        iterator insert(const_iterator position, const T& value)
+        {
+            const T copy = value;
+            return insert(position, &copy, &copy + 1);
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            T *at = m_data + (first - m_data);
+            const size_t count = last - first;
+            memmove(at, at + count, (end() - (at + count)) * sizeof(T));
+            m_size -= count;
+            return at;
+        }
+
+        iterator erase(const_iterator position) { return erase(position, position + 1); }
+
+        /* Back to the inline buffer when the elements fit in it */
+        void shrink_to_fit()
+        {
+            if (!isInline() && m_size <= N)
+            {
+                T *heap = m_data;
+                memcpy(m_inline, heap, m_size * sizeof(T));
+                ::operator delete(heap);
+                m_data = m_inline;
+                m_capacity = N;
+            }
+        }
+
+        bool operator == (const SmallVector& other) const
+            { return m_size == other.m_size && std::equal(begin(), end(), other.begin()); }
+
+        bool operator != (const SmallVector& other) const
+            { return !(*this == other); }
+
+        bool operator < (const SmallVector& other) const
+            { return std::lexicographical_compare(begin(), end(), other.begin(), other.end()); }
+
+    private:
+        T *m_data;
+        unsigned m_size;
+        unsigned m_capacity;
+        T m_inline[N];
+
+        void grow(size_t capacity)
+        {
+            T *heap = static_cast<T *>(::operator new(capacity * sizeof(T)));
+            memcpy(heap, m_data, m_size * sizeof(T));
+            release();
+            m_data = heap;
+            m_capacity = capacity;
+        }
+
+        void release()
+        {
+            if (!isInline())
+            {
+                ::operator delete(m_data);
+            }
+        }
+
+        /* Steals a heap buffer, copies an inline one; other is left empty */
+        void take(SmallVector& other)
+        {
+            if (other.isInline())
+            {
+                memcpy(m_inline, other.m_inline, other.m_size * sizeof(T));
+            }
+            else
+            {
+                m_data = other.m_data;
+                m_capacity = other.m_capacity;
+                other.m_data = other.m_inline;
+                other.m_capacity = N;
+            }
+            m_size = other.m_size;
+            other.m_size = 0;
+        }
+};
+
+}//cvrp namespace
+#endif
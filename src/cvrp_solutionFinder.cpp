@@ -1,15 +1,22 @@
 #include "cvrp_solutionFinder.h"
+#include "cvrp_checkpoint.h"
 #include "cvrp_util.h"
 #include <algorithm>
 #include <set>
 #include <omp.h>
 #include <csignal>
 #include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
 
 namespace cvrp
 {
 
-SolutionFinder::SolutionFinder(const IDataModel& model) : m_model(model), m_dnaSequence(model.getClients())
+SolutionFinder::SolutionFinder(const IDataModel& model, RouteOptimiser routes) :
+	m_model(model), m_view(model.view()), m_dnaSequence(model.getClients()), m_routes(routes)
 {
 }
 
@@ -37,11 +44,302 @@ SolutionModel SolutionFinder::getNaiveSolution(const std::vector<int>& genome) c
 	}
 	for (auto& chromosome : solution.chromosomes())
 	{
-		chromosome.optimiseCost();
+		chromosome.optimiseCost(m_routes);
 	}
 	return solution;
 }
 
+SolutionModel SolutionFinder::importSolution(const std::vector<std::vector<int>>& routes) const
+{
+	/* The only place external IDs enter the solver, check them once here */
+	std::vector<bool> seen(m_view.numberOfClients() + 1, false);
+	for (const auto& route : routes)
+	{
+		for (const auto& clientId : route)
+		{
+			if (clientId < 1 || clientId > m_view.numberOfClients() || seen[clientId])
+			{
+				std::stringstream error;
+				error << "Invalid or duplicate client ID in imported solution: " << clientId;
+				throw std::invalid_argument(error.str());
+			}
+			seen[clientId] = true;
+		}
+	}
+
+	SolutionModel solution;
+	for (const auto& route : routes)
+	{
+		if (route.empty())
+		{
+			continue;
+		}
+		solution.chromosomes().push_back(VehicleTrip(m_model));
+		for (const auto& clientId : route)
+		{
+			solution.chromosomes().back().addClientToTrip(clientId);
+		}
+		solution.chromosomes().back().optimiseCost(m_routes);
+	}
+	return solution;
+}
+
+SolutionModel SolutionFinder::warmStart(const SolutionRoutes& routes) const
+{
+	std::vector<bool> placed(m_view.numberOfClients() + 1, false);
+	SolutionModel solution;
+	for (const auto& route : routes)
+	{
+		bool newTrip = true;
+		for (const auto& clientId : route)
+		{
+			if (clientId < 1 || clientId > m_view.numberOfClients() || placed[clientId])
+			{
+				continue;
+			}
+			if (newTrip || !solution.chromosomes().back().canAccommodate(clientId))
+			{
+				solution.chromosomes().push_back(VehicleTrip(m_model));
+				newTrip = false;
+			}
+			solution.chromosomes().back().addClientToTrip(clientId);
+			placed[clientId] = true;
+		}
+	}
+
+	/* First fit: the first trip with room, the plan's trips included, before a new one */
+	for (const auto& clientId : m_dnaSequence)
+	{
+		if (placed[clientId])
+		{
+			continue;
+		}
+		auto trip = std::find_if(solution.chromosomes().begin(), solution.chromosomes().end(),
+				[clientId](const VehicleTrip& candidate) { return candidate.canAccommodate(clientId); });
+		if (trip == solution.chromosomes().end())
+		{
+			solution.chromosomes().push_back(VehicleTrip(m_model));
+			trip = solution.chromosomes().end() - 1;
+		}
+		trip->addClientToTrip(clientId);
+	}
+	for (auto& chromosome : solution.chromosomes())
+	{
+		chromosome.optimiseCost(m_routes);
+	}
+	return solution;
+}
+
+SolutionModel SolutionFinder::repair(const SolutionModel& previous, const std::vector<int>& newIds,
+		const std::vector<int>& changed, unsigned long attempts) const
+{
+	const int clients = m_view.numberOfClients();
+	std::vector<bool> isChanged(clients + 1, false);
+	for (const auto& clientId : changed)
+	{
+		isChanged[clientId] = true;
+	}
+
+	SolutionModel solution;
+	auto& trips = solution.chromosomes();
+	std::vector<bool> touched;
+	std::vector<int> pool;
+	for (const auto& oldTrip : previous.chromosomesConst())
+	{
+		bool untouched = true;
+		for (const auto& clientId : oldTrip.clientSeqConst())
+		{
+			untouched = untouched && newIds[clientId] != 0 && !isChanged[newIds[clientId]];
+		}
+		if (untouched)
+		{
+			trips.push_back(oldTrip);
+			trips.back().renumber(m_model, newIds);
+			touched.push_back(false);
+			continue;
+		}
+		/* Unchanged clients stay first, changed ones only while they still fit */
+		VehicleTrip trip(m_model);
+		for (const bool changedPass : { false, true })
+		{
+			for (const auto& oldId : oldTrip.clientSeqConst())
+			{
+				const int clientId = newIds[oldId];
+				if (clientId == 0 || isChanged[clientId] != changedPass)
+				{
+					continue;
+				}
+				if (trip.canAccommodate(clientId))
+				{
+					trip.addClientToTrip(clientId);
+				}
+				else
+				{
+					pool.push_back(clientId);
+				}
+			}
+		}
+		if (trip.getSeqSize() > 0)
+		{
+			trip.optimiseCost(m_routes);
+			trips.push_back(std::move(trip));
+			touched.push_back(true);
+		}
+	}
+
+	/* Clients the previous solution does not place: the added ones */
+	std::vector<int> tripOf(clients + 1, -1);
+	for (size_t t = 0; t < trips.size(); t++)
+	{
+		for (const auto& clientId : trips[t].clientSeqConst())
+		{
+			tripOf[clientId] = t;
+		}
+	}
+	for (const auto& clientId : changed)
+	{
+		if (tripOf[clientId] < 0 && std::find(pool.begin(), pool.end(), clientId) == pool.end())
+		{
+			pool.push_back(clientId);
+		}
+	}
+
+	/* Largest demands first, while there is the most room left */
+	std::sort(pool.begin(), pool.end(), [this](int a, int b) { return m_view.demand(a) > m_view.demand(b); });
+	const auto insertionCost = [this](const VehicleTrip& trip, int clientId, size_t& position)
+	{
+		const auto& sequence = trip.clientSeqConst();
+		Cost best = 0;
+		for (size_t i = 0; i <= sequence.size(); i++)
+		{
+			const int before = i == 0 ? 0 : sequence[i - 1];
+			const int after = i == sequence.size() ? 0 : sequence[i];
+			const Cost cost = m_view.distance(before, clientId) + m_view.distance(clientId, after) - m_view.distance(before, after);
+			if (i == 0 || cost < best)
+			{
+				best = cost;
+				position = i;
+			}
+		}
+		return best;
+	};
+	for (const auto& clientId : pool)
+	{
+		int bestTrip = -1;
+		size_t bestPosition = 0;
+		Cost bestCost = 0;
+		const auto consider = [&](int t)
+		{
+			size_t position = 0;
+			if (t < 0 || !trips[t].canAccommodate(clientId))
+			{
+				return;
+			}
+			const Cost cost = insertionCost(trips[t], clientId, position);
+			if (bestTrip < 0 || cost < bestCost)
+			{
+				bestTrip = t;
+				bestPosition = position;
+				bestCost = cost;
+			}
+		};
+		for (const auto& neighbour : m_view.neighbours(clientId))
+		{
+			consider(tripOf[neighbour]);
+		}
+		if (bestTrip < 0)
+		{
+			for (size_t t = 0; t < trips.size(); t++)
+			{
+				consider(t);
+			}
+		}
+		/* A trip of its own only when nothing has room: by the triangle inequality it never costs less */
+		if (bestTrip < 0)
+		{
+			trips.push_back(VehicleTrip(m_model));
+			touched.push_back(true);
+			bestTrip = trips.size() - 1;
+			bestPosition = 0;
+		}
+		auto& trip = trips[bestTrip];
+		trip.addClientToTrip(clientId);
+		std::rotate(trip.clientSequence().begin() + bestPosition, trip.clientSequence().end() - 1, trip.clientSequence().end());
+		/* Costed where it was priced; re-ordering here would throw the position search away */
+		trip.reEvaluateInOrder();
+		touched[bestTrip] = true;
+		tripOf[clientId] = bestTrip;
+	}
+
+	/* Local improvement: a touched trip against the trip of a neighbour of one of its clients */
+	std::vector<int> touchedTrips;
+	for (size_t t = 0; t < trips.size(); t++)
+	{
+		if (touched[t])
+		{
+			touchedTrips.push_back(t);
+		}
+	}
+	auto& prng = Util::get_prng();
+	for (unsigned long attempt = 0; attempt < attempts && !touchedTrips.empty() && trips.size() > 1; attempt++)
+	{
+		const int a = touchedTrips[std::uniform_int_distribution<size_t>(0, touchedTrips.size() - 1)(prng)];
+		if (trips[a].getSeqSize() == 0)
+		{
+			continue;
+		}
+		const auto& sequence = trips[a].clientSeqConst();
+		const int client = sequence[std::uniform_int_distribution<size_t>(0, sequence.size() - 1)(prng)];
+		const Span<const int> neighbours = m_view.neighbours(client);
+		int b = neighbours.empty() ? -1 : tripOf[neighbours[std::uniform_int_distribution<size_t>(0, neighbours.size() - 1)(prng)]];
+		if (b < 0 || b == a)
+		{
+			continue;
+		}
+		const size_t smaller = std::min(trips[a].getSeqSize(), trips[b].getSeqSize());
+		VehicleTrip first = trips[a];
+		VehicleTrip second = trips[b];
+		const int splitPoint = std::uniform_int_distribution<int>(0, smaller)(prng);
+		if (prng() & 1)
+		{
+			Util::splitAndCascade(first.clientSequence(), second.clientSequence(), splitPoint);
+		}
+		else
+		{
+			Util::splitAndFlipCascade(first.clientSequence(), second.clientSequence(), splitPoint);
+		}
+		first.reEvaluateDemandAndCost(m_routes);
+		second.reEvaluateDemandAndCost(m_routes);
+		if (first.isValidTrip() && second.isValidTrip() &&
+				first.cost() + second.cost() < trips[a].cost() + trips[b].cost())
+		{
+			trips[a] = std::move(first);
+			trips[b] = std::move(second);
+			for (const int t : { a, b })
+			{
+				for (const auto& clientId : trips[t].clientSeqConst())
+				{
+					tripOf[clientId] = t;
+				}
+			}
+			if (!touched[b])
+			{
+				touched[b] = true;
+				touchedTrips.push_back(b);
+			}
+		}
+	}
+
+	trips.erase(std::remove_if(trips.begin(), trips.end(),
+				[](const VehicleTrip& trip) { return trip.getSeqSize() == 0; }), trips.end());
+	return solution;
+}
+
+bool SolutionFinder::validateSolution(const SolutionModel& solution) const
+{
+	return solution.isValid(m_view.numberOfClients());
+}
+
 SolutionModel SolutionFinder::make_crossover(const SolutionModel& solution) const
 {
 	SolutionModel sm = solution;
@@ -51,11 +349,16 @@ SolutionModel SolutionFinder::make_crossover(const SolutionModel& solution) cons
 
 void SolutionFinder::crossover(SolutionModel& solution) const
 {
-	auto& chromosomes = solution.chromosomes();
+	const auto& chromosomes = solution.chromosomesConst();
+	/* Two distinct subjects are drawn from trips 1.., small instances may not have them */
+	if (chromosomes.size() < 3)
+	{
+		return;
+	}
 
 	std::uniform_int_distribution<int> uniform(1, chromosomes.size() - 1);
 
-	auto gen = Util::get_prng();
+	auto& gen = Util::get_prng();
 
 	int crossoverSubject1 = uniform(gen);
 	int crossoverSubject2 = uniform(gen);
@@ -67,11 +370,18 @@ void SolutionFinder::crossover(SolutionModel& solution) const
 	int smallChromosomeSize = chromosomes[crossoverSubject1].getSeqSize() < chromosomes[crossoverSubject2].getSeqSize()
 			? chromosomes[crossoverSubject1].getSeqSize()
 			: chromosomes[crossoverSubject2].getSeqSize();
+	if (smallChromosomeSize < 2)
+	{
+		return;
+	}
 
 	int crossoverPoint = std::uniform_int_distribution<int>(1, smallChromosomeSize - 1)(gen);
 
-	auto& subject1 = chromosomes[crossoverSubject1].clientSequence();
-	auto& subject2 = chromosomes[crossoverSubject2].clientSequence();
+	/* Only the two subjects change; the solution's totals are updated from them alone */
+	VehicleTrip& first = solution.beginEdit(crossoverSubject1);
+	VehicleTrip& second = solution.beginEdit(crossoverSubject2);
+	auto& subject1 = first.clientSequence();
+	auto& subject2 = second.clientSequence();
 
 	if (uniform(gen) & 1)
 	{
@@ -82,10 +392,10 @@ void SolutionFinder::crossover(SolutionModel& solution) const
 		Util::splitAndFlipCascade(subject1, subject2, crossoverPoint);
 	}
 
-	for (auto& chromosome : chromosomes)
-	{
-		chromosome.reEvaluateDemandAndCost();
-	}
+	first.reEvaluateDemandAndCost(m_routes);
+	second.reEvaluateDemandAndCost(m_routes);
+	solution.endEdit(crossoverSubject1);
+	solution.endEdit(crossoverSubject2);
 }
 
 std::atomic_bool sigend{false};
@@ -95,49 +405,58 @@ void sigend_handler(int)
 	sigend = true;
 }
 
-SolutionModel SolutionFinder::solutionWithEvolution() const
+bool SolutionFinder::interrupted()
 {
-	constexpr unsigned long max_generations = 100;
-	constexpr unsigned long max_mutations_per_generation = 10'000'000'000;
-	constexpr unsigned long max_contiguous_null_generations = 3;
-	constexpr unsigned long initial_population = 100'000;
-	constexpr unsigned long max_population = 10'000'000;
-	constexpr unsigned long max_mutations_per_subject = 100'000;
+	return sigend;
+}
 
-	const bool progress = !getenv("HIDE_PROGRESS");
-	const bool benching = getenv("BENCH");
+SolutionModel SolutionFinder::solutionWithEvolution(const EvolutionOptions& options) const
+{
+	return solutionWithEvolution(options, std::vector<SolutionModel>());
+}
+
+SolutionModel SolutionFinder::solutionWithEvolution(const EvolutionOptions& options, const std::vector<SolutionModel>& start) const
+{
+	const unsigned long max_generations = options.maxGenerations;
+	const unsigned long max_mutations_per_generation = options.maxMutationsPerGeneration;
+	const unsigned long max_contiguous_null_generations = options.maxContiguousNullGenerations;
+	const unsigned long initial_population = options.initialPopulation;
+	const unsigned long max_population = options.maxPopulation;
+	const unsigned long max_mutations_per_subject = options.maxMutationsPerSubject;
+
+	const bool progress = options.progress;
+	const bool benching = options.allGenerations;
 
 	std::signal(SIGINT, sigend_handler);
 	std::signal(SIGTERM, sigend_handler);
 
+	/* Solutions with the same cost and hash are taken for the same one, so the population holds each once */
 	struct CostedSolution
 	{
-		double cost;
+		Cost cost;
+		uint64_t hash;
 		SolutionModel model;
 		CostedSolution(SolutionModel&& model) :
 			cost(model.getCost()),
+			hash(model.hash()),
 			model(std::move(model))
 			{ }
 		CostedSolution(const SolutionModel& model) :
 			cost(model.getCost()),
+			hash(model.hash()),
 			model(model)
 			{ }
 		bool operator == (const CostedSolution& other) const
-			{ return cost == other.cost && model == other.model; }
+			{ return cost == other.cost && hash == other.hash; }
 		bool operator < ( const CostedSolution& other) const
-			{ return cost < other.cost || model < other.model; }
+			{ return PopulationOrder()(model, other.model); }
 	};
 
 	struct CostedSolutionHash
 	{
 		size_t operator () (const CostedSolution& x) const
 		{
-			union {
-				size_t s;
-				double d;
-			} t;
-			t.d = x.cost;
-			return t.s ^ x.model.hash();
+			return x.hash;
 		}
 	};
 
@@ -155,67 +474,204 @@ SolutionModel SolutionFinder::solutionWithEvolution() const
 
 	using ResultSet = std::set<CostedSolution, CostedSolutionCompare>;
 
-	ResultSet population;
+	/* Each round replaces rather than changes it, so a checkpoint can hold on to a round's population */
+	auto population = std::make_shared<ResultSet>();
 	unsigned null_generations = 0;
+	/* Local rather than omp critical, which is one lock for every solve in a batch */
+	std::mutex populationLock;
 
-	Util::seed_prngs();
+	Util::seed_prngs(options.seed);
 
-	/* Initial population */
-	printf("Initialising %'lu random solutions\n", initial_population);
-	#pragma omp parallel
+	using Clock = std::chrono::steady_clock;
+	const bool limited = options.timeLimit > 0;
+	const Clock::time_point deadline = Clock::now() +
+		std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(limited ? options.timeLimit : 0));
+	/* Latched, so that the loops only read the clock now and then */
+	std::atomic_bool stopped{false};
+	const auto stopping = [&]()
 	{
-		ResultSet buf;
-		auto& prng = Util::get_prng();
-		auto genome = m_dnaSequence;
-#pragma omp for
-		for (unsigned long i = 0; i < initial_population; ++i)
+		if (!stopped && (sigend || (limited && Clock::now() >= deadline)))
 		{
-			std::shuffle(genome.begin(), genome.end(), prng);
-			const auto it = buf.emplace(getNaiveSolution(genome));
-			if (!it.second)
+			stopped = true;
+		}
+		return stopped.load();
+	};
+
+	/* Resuming: the checkpointed population, generator states and counters */
+	const uint64_t fingerprint = Checkpoint::fingerprint(m_view);
+	unsigned long first_generation = 0;
+	if (!options.resumePath.empty())
+	{
+		CheckpointState resumed = Checkpoint::read(options.resumePath);
+		if (resumed.fingerprint != fingerprint)
+		{
+			throw std::invalid_argument(options.resumePath + ": checkpoint of another instance");
+		}
+		for (const auto& routes : resumed.population)
+		{
+			population->emplace(importSolution(routes));
+		}
+		first_generation = resumed.generation;
+		null_generations = resumed.nullGenerations;
+		#pragma omp parallel
+		{
+			const size_t thread = omp_get_thread_num();
+			if (thread < resumed.prngs.size() && !resumed.prngs[thread].empty())
 			{
-				continue;
+				Util::restore_prng(resumed.prngs[thread]);
+			}
+		}
+		if (progress)
+		{
+			fprintf(stderr, "Resuming %'zu solutions at round %'lu from %s\n", population->size(), first_generation, options.resumePath.c_str());
+		}
+	}
+	else
+	{
+		/* Initial population */
+		if (progress)
+		{
+			fprintf(stderr, start.empty() ? "Initialising %'lu random solutions\n" : "Initialising %'lu solutions around the start ones\n", initial_population);
+		}
+		for (const auto& solution : start)
+		{
+			if (solution.isFeasible())
+			{
+				population->emplace(solution);
 			}
 		}
-#pragma omp critical
+		/* Each start solution is perturbed by a few crossovers, keeping the last feasible step */
+		const int max_perturbation = 8;
+		#pragma omp parallel
 		{
-			population.merge(std::move(buf));
+			ResultSet buf;
+			auto& prng = Util::get_prng();
+			auto genome = m_dnaSequence;
+			std::uniform_int_distribution<int> perturbation(1, max_perturbation);
+	#pragma omp for
+			for (unsigned long i = 0; i < initial_population; ++i)
+			{
+				if (!buf.empty() && stopping())
+				{
+					continue;
+				}
+				if (start.empty())
+				{
+					std::shuffle(genome.begin(), genome.end(), prng);
+					buf.emplace(getNaiveSolution(genome));
+					continue;
+				}
+				SolutionModel perturbed = start[i % start.size()];
+				for (int step = perturbation(prng); step > 0; --step)
+				{
+					SolutionModel next = make_crossover(perturbed);
+					if (next.isFeasible())
+					{
+						perturbed = std::move(next);
+					}
+				}
+				if (perturbed.isFeasible())
+				{
+					buf.emplace(std::move(perturbed));
+				}
+			}
+			{
+				std::lock_guard<std::mutex> lock(populationLock);
+				population->merge(std::move(buf));
+			}
 		}
 	}
+	if (population->empty())
+	{
+		/* Only infeasible start solutions, or a time limit too short for anything else */
+		population->emplace(getNaiveSolution(m_dnaSequence));
+	}
 
-	printf("max_generations=%'lu, max_mutations_per_generation=%'lu, max_contiguous_null_generations=%'lu\ninitial_population=%'lu, max_population=%'lu\n", max_generations, max_mutations_per_generation, max_contiguous_null_generations, initial_population, max_population);
+	if (progress)
+	{
+		fprintf(stderr, "max_generations=%'lu, max_mutations_per_generation=%'lu, max_contiguous_null_generations=%'lu\ninitial_population=%'lu, max_population=%'lu\n", max_generations, max_mutations_per_generation, max_contiguous_null_generations, initial_population, max_population);
+	}
 
-	for (unsigned long generation_num = 0; generation_num < max_generations; ++generation_num)
+	/* Hands the writer the round's population, to flatten, encode and write on its own thread */
+	std::unique_ptr<CheckpointWriter> checkpointWriter;
+	if (!options.checkpointPath.empty())
 	{
+		checkpointWriter.reset(new CheckpointWriter(options.checkpointPath));
+	}
+	const auto interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(options.checkpointInterval));
+	Clock::time_point next_checkpoint = Clock::now() + interval;
+	const auto checkpoint = [&](unsigned long generation_num)
+	{
+		/* Generator states are per thread, so they are saved here; the population is flattened on the writer's thread */
+		std::vector<std::vector<uint32_t>> prngs(omp_get_max_threads());
+		#pragma omp parallel
+		{
+			prngs[omp_get_thread_num()] = Util::save_prng();
+		}
+		std::shared_ptr<const ResultSet> snapshot = population;
+		const uint64_t nullGenerations = null_generations;
+		checkpointWriter->submit([fingerprint, generation_num, nullGenerations, snapshot, prngs = std::move(prngs)]() mutable
+		{
+			CheckpointState state;
+			state.fingerprint = fingerprint;
+			state.generation = generation_num;
+			state.nullGenerations = nullGenerations;
+			state.population.reserve(snapshot->size());
+			for (const auto& subject : *snapshot)
+			{
+				SolutionRoutes routes;
+				for (const auto& trip : subject.model.chromosomesConst())
+				{
+					routes.emplace_back(trip.clientSeqConst().begin(), trip.clientSeqConst().end());
+				}
+				state.population.push_back(std::move(routes));
+			}
+			state.prngs = std::move(prngs);
+			return state;
+		});
+		next_checkpoint = Clock::now() + interval;
+	};
+
+	unsigned long completed_generations = first_generation;
+	for (unsigned long generation_num = first_generation; generation_num < max_generations; ++generation_num)
+	{
+		if (checkpointWriter && Clock::now() >= next_checkpoint)
+		{
+			checkpoint(generation_num);
+		}
 		ResultSet generation;
 		if (progress)
 		{
-			fprintf(stderr, "\rpopulation=%'zu, round=%'lu/%'lu (%.1f%%), score=%.1f, null rounds=%'u            ", population.size(), generation_num, max_generations, (generation_num * 100.0 / max_generations), population.begin()->cost, null_generations);
+			fprintf(stderr, "\rpopulation=%'zu, round=%'lu/%'lu (%.1f%%), score=%.1f, null rounds=%'u            ", population->size(), generation_num, max_generations, (generation_num * 100.0 / max_generations), (double) population->begin()->cost, null_generations);
 		}
-		const auto threshold = (--population.end())->cost;
-		const auto mutations_per_subject = std::min<size_t>(max_mutations_per_generation / population.size(), max_mutations_per_subject);
-		const bool parallel_outer = population.size() > (unsigned) omp_get_num_threads() * 20;
+		const auto threshold = (--population->end())->cost;
+		const auto mutations_per_subject = std::min<size_t>(max_mutations_per_generation / population->size(), max_mutations_per_subject);
+		const bool parallel_outer = population->size() > (unsigned) omp_get_num_threads() * 20;
 		/* Buffer in contiguous container for simple parallelisation */
 		std::vector<const CostedSolution *> contiguous;
-		for (const auto& subject : population)
+		for (const auto& subject : *population)
 		{
 			contiguous.emplace_back(&subject);
 		}
 #pragma omp parallel for if(parallel_outer)
 		for (size_t n = 0; n < contiguous.size(); ++n)
 		{
+			if (stopping())
+			{
+				continue;
+			}
 			const auto& oldSol = *contiguous[n];
 #pragma omp parallel for if(!parallel_outer)
 			for (unsigned long mutation = 0; mutation < mutations_per_subject; mutation++)
 			{
-				if (sigend)
+				if (stopped || ((mutation & 63) == 0 && stopping()))
 				{
 					continue;
 				}
 				auto newSol = CostedSolution(make_crossover(oldSol.model));
-				if (newSol.cost < threshold && newSol.model.isValid(m_model.numberOfClients()))
-#pragma omp critical
+				if (newSol.cost < threshold && newSol.model.isFeasible())
 				{
+					std::lock_guard<std::mutex> lock(populationLock);
 					if (generation.empty() || newSol.cost < (--generation.end())->cost)
 					{
 						if (generation.size() == max_population)
@@ -227,21 +683,27 @@ SolutionModel SolutionFinder::solutionWithEvolution() const
 				}
 			}
 		}
-		if (!generation.empty() && generation.begin()->cost < population.begin()->cost)
+		/* A round cut short by a stop is kept if it improved, but runs again in full on resuming */
+		const bool cut_short = stopped;
+		if (!cut_short)
+		{
+			completed_generations = generation_num + 1;
+		}
+		if (!generation.empty() && generation.begin()->cost < population->begin()->cost)
 		{
 			null_generations = 0;
-			population = std::move(generation);
+			population = std::make_shared<ResultSet>(std::move(generation));
 			if (progress)
 			{
 				fprintf(stderr, "\n");
 			}
-		} else {
+		} else if (!cut_short) {
 			null_generations++;
-			if (null_generations == max_contiguous_null_generations && !benching) {
+			if (null_generations >= max_contiguous_null_generations && !benching) {
 				break;
 			}
 		}
-		if (sigend)
+		if (stopping())
 		{
 			break;
 		}
@@ -251,8 +713,12 @@ SolutionModel SolutionFinder::solutionWithEvolution() const
 	{
 		fprintf(stderr, "\n");
 	}
+	if (checkpointWriter)
+	{
+		checkpoint(completed_generations);
+	}
 
-	return std::move(population.begin()->model);
+	return std::move(population->begin()->model);
 }
 
 }//cvrp namespace
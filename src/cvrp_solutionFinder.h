@@ -1,26 +1,79 @@
 #ifndef CVRP_SOLUTION_FINDER
 #define CVRP_SOLUTION_FINDER
 
+#include <string>
 #include "cvrp_idataModel.h"
 #include "cvrp_solutionModel.h"
+#include "cvrp_solutionReader.h"
 
 namespace cvrp
 {
+/* Budget of one evolution run; the defaults are the long-standing single instance settings */
+struct EvolutionOptions
+{
+    unsigned long maxGenerations = 100;
+    unsigned long maxMutationsPerGeneration = 10'000'000'000;
+    unsigned long maxContiguousNullGenerations = 3;
+    unsigned long initialPopulation = 100'000;
+    unsigned long maxPopulation = 10'000'000;
+    unsigned long maxMutationsPerSubject = 100'000;
+    /* Progress lines on stderr (HIDE_PROGRESS unset) */
+    bool progress = true;
+    /* Run every generation even when nothing improves (BENCH set) */
+    bool allGenerations = false;
+    /* Wall clock budget in seconds, 0 for none; the best solution so far is returned when it runs out */
+    double timeLimit = 0;
+    /* Seed for the generators, 0 for a random one; runs only repeat exactly on a single thread */
+    unsigned long seed = 0;
+    /* Checkpoint written every checkpointInterval seconds and when the run ends, none if empty */
+    std::string checkpointPath;
+    double checkpointInterval = 60;
+    /* Checkpoint to carry on from instead of building an initial population */
+    std::string resumePath;
+};
+
 class SolutionFinder
 {
     public:
-        SolutionFinder(const IDataModel& model);
+        /* Every trip the finder builds or changes is ordered with routes */
+        SolutionFinder(const IDataModel& model, RouteOptimiser routes = RouteOptimiser::Greedy);
 
         SolutionModel getNaiveSolution(const std::vector<int>& genome) const;
+        SolutionModel importSolution(const std::vector<std::vector<int>>& routes) const;
+        /*
+         * A prior plan made to fit this instance, which may have changed since:
+         * unknown and repeated clients are dropped, routes over capacity are
+         * split and clients the plan misses go to the first trip with room,
+         * opening a new one only when none has any.
+         */
+        SolutionModel warmStart(const SolutionRoutes& routes) const;
+        /*
+         * Carries previous, a solution of the instance an InstanceDelta was
+         * applied to, over to this finder's model, the edited one.  Trips
+         * without removed or changed clients are reused as they are; the
+         * others drop removed clients and evict changed ones that no longer
+         * fit.  Evicted and added clients go to the cheapest insertion among
+         * the trips of their nearest neighbours, then up to attempts
+         * crossovers between touched trips and others are kept when they
+         * lower the cost.
+         */
+        SolutionModel repair(const SolutionModel& previous, const std::vector<int>& newIds,
+                const std::vector<int>& changed, unsigned long attempts = 2'000) const;
         bool validateSolution(const SolutionModel& solution) const;
-        SolutionModel solutionWithEvolution() const;
+        SolutionModel solutionWithEvolution(const EvolutionOptions& options = EvolutionOptions()) const;
+        /* Starts from the given solutions and perturbations of them instead of random ones */
+        SolutionModel solutionWithEvolution(const EvolutionOptions& options, const std::vector<SolutionModel>& start) const;
+        SolutionModel make_crossover(const SolutionModel& solution) const;
+        /* Set by SIGINT / SIGTERM once a solve has started; it stops that solve and any later one */
+        static bool interrupted();
 
     private:
         const IDataModel& m_model;
+        const ModelView& m_view;
         const std::vector<int> m_dnaSequence;
+        const RouteOptimiser m_routes;
 
         void crossover(SolutionModel& solution) const;
-        SolutionModel make_crossover(const SolutionModel& solution) const;
 };
 
 }//cvrp namespace
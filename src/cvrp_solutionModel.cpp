@@ -6,21 +6,14 @@ namespace cvrp
 
 void SolutionModel::printSolution()
 {
+	std::string trips;
 	for (std::vector<VehicleTrip>::const_iterator it = m_solution.begin();
 			it != m_solution.end(); ++it)
 	{
-		std::cout << it->getTripStr() << std::endl;
+		it->appendTripStr(trips);
+		trips += '\n';
 	}
-}
-
-double SolutionModel::getCost() const
-{
-	double totalCost = 0.0;
-	for (const auto& chromosome : chromosomesConst())
-	{
-		totalCost += chromosome.cost();
-	}
-	return totalCost;
+	std::cout << trips << std::flush;
 }
 
 bool SolutionModel::isValid(int num_clients) const
@@ -34,7 +27,7 @@ bool SolutionModel::isValid(int num_clients) const
 		}
 		for (const auto& clientSeq : chromosome.clientSeqConst())
 		{
-			if (check[clientSeq])
+			if (clientSeq < 1 || clientSeq > num_clients || check[clientSeq])
 			{
 				return false;
 			}
@@ -51,21 +44,18 @@ bool SolutionModel::isValid(int num_clients) const
 	return true;
 }
 
-size_t SolutionModel::hash() const
+void SolutionModel::recalculate() const
 {
-	size_t ret = 1;
-	for (const auto& x : m_solution)
+	m_cost = 0;
+	m_hash = 0;
+	m_infeasible = 0;
+	for (const auto& chromosome : m_solution)
 	{
-		ret++;
-		auto h = x.hash();
-		if (!h)
-		{
-			h = 1;
-		}
-		ret *= h;
-		ret ^= h*h;
+		m_cost += chromosome.cost();
+		m_hash ^= chromosome.hash();
+		m_infeasible += chromosome.isValidTrip() ? 0 : 1;
 	}
-	return ret;
+	m_cached = true;
 }
 
 }//cvrp namespace
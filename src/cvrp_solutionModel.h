@@ -6,14 +6,26 @@
 
 namespace cvrp
 {
+/*
+ * The total cost, the hash and the number of trips over capacity are
+ * cached.  An edit through chromosomes() drops the cache and the next read
+ * rebuilds it, so do not hold that reference across a read, and read a
+ * solution once before sharing it between threads.  beginEdit/endEdit
+ * bracket an edit of one trip and keep the cache in O(1).
+ */
 class SolutionModel
 {
     public:
-        std::vector<VehicleTrip>& chromosomes() { return m_solution; }
+        SolutionModel() : m_cost(0), m_hash(0), m_infeasible(0), m_cached(true) {}
+
+        std::vector<VehicleTrip>& chromosomes() { m_cached = false; return m_solution; }
         const std::vector<VehicleTrip>& chromosomesConst() const { return m_solution; }
+        VehicleTrip& beginEdit(size_t trip) { account(m_solution[trip], -1); return m_solution[trip]; }
+        void endEdit(size_t trip) { account(m_solution[trip], 1); }
         void printSolution();
-        double getCost() const;
+        Cost getCost() const { cache(); return m_cost; }
         bool isValid(int num_clients) const;
+        bool isFeasible() const { cache(); return m_infeasible == 0; }
 
         bool operator == (const SolutionModel& other) const
             { return m_solution == other.m_solution; }
@@ -21,10 +33,45 @@ class SolutionModel
         bool operator < (const SolutionModel& other) const
             { return m_solution < other.m_solution; }
 
-        size_t hash() const;
+        /* XOR of the trip hashes, so independent of the order of the trips */
+        uint64_t hash() const { cache(); return m_hash; }
 
     private:
         std::vector<VehicleTrip> m_solution;
+        mutable Cost m_cost;
+        mutable uint64_t m_hash;
+        mutable int m_infeasible;
+        mutable bool m_cached;
+
+        void cache() const
+        {
+            if (!m_cached)
+            {
+                recalculate();
+            }
+        }
+        void recalculate() const;
+        /* Adds (sign 1) or takes out (sign -1) a trip's share of the cached totals */
+        void account(const VehicleTrip& trip, int sign)
+        {
+            if (m_cached)
+            {
+                m_cost += sign * trip.cost();
+                m_hash ^= trip.hash();
+                m_infeasible += trip.isValidTrip() ? 0 : sign;
+            }
+        }
+};
+
+/*
+ * How a population orders and deduplicates solutions: by cost, then hash.
+ * Solutions it cannot tell apart have the same edges, whatever the order
+ * of their trips, so a population keeps only one of them.
+ */
+struct PopulationOrder
+{
+    bool operator () (const SolutionModel& a, const SolutionModel& b) const
+        { return a.getCost() < b.getCost() || (a.getCost() == b.getCost() && a.hash() < b.hash()); }
 };
 
 }//cvrp namespace
@@ -0,0 +1,89 @@
+#include "cvrp_solutionReader.h"
+
+#include <climits>
+#include <sstream>
+#include <stdexcept>
+
+namespace cvrp
+{
+
+namespace
+{
+[[noreturn]] void fail(const std::string& name, int line, const std::string& reason) __attribute__((cold, noinline));
+
+void fail(const std::string& name, int line, const std::string& reason)
+{
+    std::stringstream error;
+    error << name << ":" << line << ": " << reason;
+    throw std::invalid_argument(error.str());
+}
+
+/* x->a->b->x with an optional " ------- load" */
+std::vector<int> parseRoute(std::string_view line, const std::string& name, int lineNumber)
+{
+    std::vector<int> route;
+    line.remove_prefix(3);
+    while (!line.empty() && line.front() != 'x')
+    {
+        long id = 0;
+        size_t digits = 0;
+        while (digits < line.size() && line[digits] >= '0' && line[digits] <= '9' && id <= INT_MAX)
+        {
+            id = id * 10 + (line[digits++] - '0');
+        }
+        if (digits == 0 || id > INT_MAX)
+        {
+            fail(name, lineNumber, "expected a client ID");
+        }
+        if (line.substr(digits, 2) != "->")
+        {
+            fail(name, lineNumber, "expected '->'");
+        }
+        route.push_back(id);
+        line.remove_prefix(digits + 2);
+    }
+    if (line.empty())
+    {
+        fail(name, lineNumber, "route does not return to the depot");
+    }
+    line.remove_prefix(1);
+    const size_t load = line.find_first_not_of(" -\t");
+    if (load != std::string_view::npos && line.find_first_not_of("0123456789 \t\r", load) != std::string_view::npos)
+    {
+        fail(name, lineNumber, "unexpected text after the route");
+    }
+    return route;
+}
+}
+
+std::vector<SolutionRoutes> SolutionReader::parse(std::string_view text, const std::string& name)
+{
+    std::vector<SolutionRoutes> solutions;
+    bool inSolution = false;
+    int lineNumber = 0;
+    while (!text.empty())
+    {
+        const size_t end = std::min(text.find('\n'), text.size());
+        std::string_view line = text.substr(0, end);
+        text.remove_prefix(std::min(end + 1, text.size()));
+        lineNumber++;
+        while (!line.empty() && (line.front() == ' ' || line.front() == '\t'))
+        {
+            line.remove_prefix(1);
+        }
+        if (line.substr(0, 3) != "x->")
+        {
+            inSolution = false;
+            continue;
+        }
+        if (!inSolution)
+        {
+            solutions.emplace_back();
+            inSolution = true;
+        }
+        solutions.back().push_back(parseRoute(line, name, lineNumber));
+    }
+    return solutions;
+}
+
+}//cvrp namespace
@@ -0,0 +1,32 @@
+#ifndef CVRP_SOLUTION_READER
+#define CVRP_SOLUTION_READER
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cvrp
+{
+/* Routes of one solution, each the client IDs in visiting order */
+typedef std::vector<std::vector<int>> SolutionRoutes;
+
+/*
+ * Reads solutions in the text format the solver prints, as collected in
+ * data/SomeOfTheBestSolutions.txt:
+ *
+ *   x->4->45->29->x ------- 207
+ *   x->51->16->x ------- 197
+ *   Total Cost: 790.345
+ *
+ * Consecutive route lines make one solution; any other line (totals,
+ * separators, notes) ends it.  The load after the dashes is optional and
+ * ignored, it is recomputed from the instance.
+ */
+class SolutionReader
+{
+    public:
+        static std::vector<SolutionRoutes> parse(std::string_view text, const std::string& name);
+};
+
+}//cvrp namespace
+#endif
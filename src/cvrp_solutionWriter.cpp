@@ -0,0 +1,173 @@
+#include "cvrp_solutionWriter.h"
+
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace cvrp
+{
+
+namespace
+{
+void appendInt(std::string& out, long value)
+{
+    char digits[24];
+    out.append(digits, std::to_chars(digits, digits + sizeof(digits), value).ptr);
+}
+
+/* Shortest round-trip form for JSON, printf %g as std::cout prints it for text */
+void appendCost(std::string& out, Cost cost, bool exact)
+{
+#ifdef CVRP_ROUNDED_DISTANCES
+    (void) exact;
+    appendInt(out, cost);
+#else
+    char digits[32];
+    const std::to_chars_result result = exact ?
+        std::to_chars(digits, digits + sizeof(digits), cost) :
+        std::to_chars(digits, digits + sizeof(digits), cost, std::chars_format::general, 6);
+    out.append(digits, result.ptr);
+#endif
+}
+
+template <typename T>
+void appendRaw(std::string& out, const T& value)
+{
+    out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+}
+
+SolutionFormat SolutionWriter::parseFormat(const std::string& name)
+{
+    if (name == "text")
+    {
+        return SolutionFormat::Text;
+    }
+    if (name == "json")
+    {
+        return SolutionFormat::Json;
+    }
+    if (name == "binary")
+    {
+        return SolutionFormat::Binary;
+    }
+    throw std::invalid_argument("Unknown solution format: " + name);
+}
+
+const char *SolutionWriter::extension(SolutionFormat format)
+{
+    switch (format)
+    {
+    case SolutionFormat::Json:
+        return "json";
+    case SolutionFormat::Binary:
+        return "bin";
+    default:
+        return "txt";
+    }
+}
+
+void SolutionWriter::render(const SolutionModel& solution, SolutionFormat format, std::string& out)
+{
+    switch (format)
+    {
+    case SolutionFormat::Text:
+        renderText(solution, out);
+        break;
+    case SolutionFormat::Json:
+        renderJson(solution, out);
+        break;
+    case SolutionFormat::Binary:
+        renderBinary(solution, out);
+        break;
+    }
+}
+
+void SolutionWriter::write(int fd, const SolutionModel& solution, SolutionFormat format)
+{
+    std::string out;
+    render(solution, format, out);
+    const char *data = out.data();
+    size_t left = out.size();
+    /* One write, unless the descriptor takes less (a full pipe) or a signal interrupts it */
+    while (left > 0)
+    {
+        const ssize_t count = ::write(fd, data, left);
+        if (count < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw std::runtime_error(std::string("Cannot write the solution: ") + strerror(errno));
+        }
+        data += count;
+        left -= count;
+    }
+}
+
+void SolutionWriter::renderText(const SolutionModel& solution, std::string& out)
+{
+    for (const auto& trip : solution.chromosomesConst())
+    {
+        trip.appendTripStr(out);
+        out += '\n';
+    }
+    out += "Total Cost: ";
+    appendCost(out, solution.getCost(), false);
+    out += "\n##################################################################\n";
+}
+
+void SolutionWriter::renderJson(const SolutionModel& solution, std::string& out)
+{
+    out += "{\"cost\":";
+    appendCost(out, solution.getCost(), true);
+    out += ",\"routes\":[";
+    bool firstTrip = true;
+    for (const auto& trip : solution.chromosomesConst())
+    {
+        out += firstTrip ? "{\"clients\":[" : ",{\"clients\":[";
+        firstTrip = false;
+        bool firstClient = true;
+        for (int clientId : trip.clientSeqConst())
+        {
+            if (!firstClient)
+            {
+                out += ',';
+            }
+            firstClient = false;
+            appendInt(out, clientId);
+        }
+        out += "],\"load\":";
+        appendInt(out, trip.demandCovered());
+        out += ",\"cost\":";
+        appendCost(out, trip.cost(), true);
+        out += '}';
+    }
+    out += "]}\n";
+}
+
+void SolutionWriter::renderBinary(const SolutionModel& solution, std::string& out)
+{
+    BinarySolutionHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "CVRPSOL", 8);
+    header.version = binaryVersion;
+    header.routes = solution.chromosomesConst().size();
+    header.cost = solution.getCost();
+    appendRaw(out, header);
+    for (const auto& trip : solution.chromosomesConst())
+    {
+        BinaryRouteHeader route;
+        memset(&route, 0, sizeof(route));
+        route.clients = trip.getSeqSize();
+        route.load = trip.demandCovered();
+        route.cost = trip.cost();
+        appendRaw(out, route);
+        out.append(reinterpret_cast<const char *>(trip.clientSeqConst().data()), trip.getSeqSize() * sizeof(int));
+    }
+}
+
+}//cvrp namespace
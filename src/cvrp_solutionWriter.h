@@ -0,0 +1,55 @@
+#ifndef CVRP_SOLUTION_WRITER
+#define CVRP_SOLUTION_WRITER
+
+#include <cstdint>
+#include <string>
+#include "cvrp_solutionModel.h"
+
+namespace cvrp
+{
+enum class SolutionFormat
+{
+    Text,   /* "x->4->30->x ------- 220" per trip, then the total, as printed so far */
+    Json,   /* {"cost":..,"routes":[{"clients":[..],"load":..,"cost":..},..]} on one line */
+    Binary  /* BinarySolutionHeader, then per route a BinaryRouteHeader and its int32 client IDs */
+};
+
+/* Native byte order throughout; costs are doubles in either cost build */
+struct BinarySolutionHeader
+{
+    char magic[8];          /* "CVRPSOL" */
+    uint32_t version;
+    uint32_t routes;
+    double cost;
+};
+
+struct BinaryRouteHeader
+{
+    uint32_t clients;
+    int32_t load;
+    double cost;
+};
+
+/*
+ * Renders a whole solution into one buffer, so that it leaves in a single
+ * write instead of a flush per line.
+ */
+class SolutionWriter
+{
+    public:
+        static constexpr uint32_t binaryVersion = 1;
+
+        static SolutionFormat parseFormat(const std::string& name);
+        /* File extension for results written in this format: txt, json or bin */
+        static const char *extension(SolutionFormat format);
+        static void render(const SolutionModel& solution, SolutionFormat format, std::string& out);
+        static void write(int fd, const SolutionModel& solution, SolutionFormat format);
+
+    private:
+        static void renderText(const SolutionModel& solution, std::string& out);
+        static void renderJson(const SolutionModel& solution, std::string& out);
+        static void renderBinary(const SolutionModel& solution, std::string& out);
+};
+
+}//cvrp namespace
+#endif
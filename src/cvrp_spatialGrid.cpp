@@ -0,0 +1,173 @@
+#include "cvrp_spatialGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace cvrp
+{
+
+void SpatialGrid::build(Span<const int> xs, Span<const int> ys)
+{
+    const int n = xs.size();
+    if (n < 2)
+    {
+        m_columns = m_rows = 0;
+        m_cellStart.assign(1, 0);
+        m_ids.clear();
+        return;
+    }
+
+    int maxX = xs[1], maxY = ys[1];
+    m_minX = xs[1];
+    m_minY = ys[1];
+    for (int i = 2; i < n; i++)
+    {
+        m_minX = std::min(m_minX, xs[i]);
+        m_minY = std::min(m_minY, ys[i]);
+        maxX = std::max(maxX, xs[i]);
+        maxY = std::max(maxY, ys[i]);
+    }
+    const double width = maxX - m_minX + 1.0;
+    const double height = maxY - m_minY + 1.0;
+    const double cells = std::max(1, (n - 1) / 2);
+    m_cellSize = std::max(1L, (long) std::ceil(std::sqrt(width * height / cells)));
+    m_columns = (maxX - m_minX) / m_cellSize + 1;
+    m_rows = (maxY - m_minY) / m_cellSize + 1;
+
+    /* Counting sort of client IDs by cell */
+    m_cellStart.assign((size_t) m_columns * m_rows + 1, 0);
+    for (int i = 1; i < n; i++)
+    {
+        m_cellStart[row(ys[i]) * m_columns + column(xs[i]) + 1]++;
+    }
+    for (size_t c = 1; c < m_cellStart.size(); c++)
+    {
+        m_cellStart[c] += m_cellStart[c - 1];
+    }
+    m_ids.resize(n - 1);
+    m_cellXs.resize(n - 1);
+    m_cellYs.resize(n - 1);
+    std::vector<int> fill(m_cellStart.begin(), m_cellStart.end() - 1);
+    for (int i = 1; i < n; i++)
+    {
+        int slot = fill[row(ys[i]) * m_columns + column(xs[i])]++;
+        m_ids[slot] = i;
+        m_cellXs[slot] = xs[i];
+        m_cellYs[slot] = ys[i];
+    }
+}
+
+int SpatialGrid::column(long x) const
+{
+    return std::min<long>(std::max<long>(0, (x - m_minX) / m_cellSize), m_columns - 1);
+}
+
+int SpatialGrid::row(long y) const
+{
+    return std::min<long>(std::max<long>(0, (y - m_minY) / m_cellSize), m_rows - 1);
+}
+
+void SpatialGrid::scanCells(int x, int y, int firstCell, int lastCell, int k, int exclude,
+        std::vector<std::pair<long, int>>& best, int& found) const
+{
+    static thread_local std::vector<double> squared;
+    const int begin = m_cellStart[firstCell];
+    const int end = m_cellStart[lastCell + 1];
+    squared.resize(end - begin);
+    Util::squaredDistancesFrom(x, y, m_cellXs.data() + begin, m_cellYs.data() + begin, end - begin, squared.data());
+    for (int c = begin; c < end; c++)
+    {
+        const int id = m_ids[c];
+        std::pair<long, int> candidate((long) squared[c - begin], id);
+        if (id == exclude || (found == k && !(candidate < best[k - 1])))
+        {
+            continue;
+        }
+        int slot = found < k ? found++ : k - 1;
+        for (; slot > 0 && candidate < best[slot - 1]; slot--)
+        {
+            best[slot] = best[slot - 1];
+        }
+        best[slot] = candidate;
+    }
+}
+
+void SpatialGrid::nearest(int x, int y, int k, std::vector<int>& out, int exclude) const
+{
+    out.clear();
+    if (k <= 0 || m_ids.empty())
+    {
+        return;
+    }
+    static thread_local std::vector<std::pair<long, int>> best;
+    best.resize(k);
+    int found = 0;
+
+    const int cx = column(x);
+    const int cy = row(y);
+    const int maxRing = std::max(std::max(cx, m_columns - 1 - cx), std::max(cy, m_rows - 1 - cy));
+    for (int ring = 0; ring <= maxRing; ring++)
+    {
+        const int firstColumn = std::max(0, cx - ring);
+        const int lastColumn = std::min(m_columns - 1, cx + ring);
+        for (int gy = std::max(0, cy - ring); gy <= std::min(m_rows - 1, cy + ring); gy++)
+        {
+            if (gy == cy - ring || gy == cy + ring)
+            {
+                scanCells(x, y, gy * m_columns + firstColumn, gy * m_columns + lastColumn, k, exclude, best, found);
+                continue;
+            }
+            /* Interior rows only contribute their two edge cells */
+            if (cx - ring >= 0)
+            {
+                scanCells(x, y, gy * m_columns + cx - ring, gy * m_columns + cx - ring, k, exclude, best, found);
+            }
+            if (cx + ring < m_columns)
+            {
+                scanCells(x, y, gy * m_columns + cx + ring, gy * m_columns + cx + ring, k, exclude, best, found);
+            }
+        }
+        /* Anything in ring r+1 is at least r cells away along one axis */
+        const long bound = ring * m_cellSize;
+        if (found == k && best[k - 1].first < bound * bound)
+        {
+            break;
+        }
+    }
+    for (int i = 0; i < found; i++)
+    {
+        out.push_back(best[i].second);
+    }
+}
+
+void SpatialGrid::withinRadius(int x, int y, double radius, std::vector<int>& out) const
+{
+    out.clear();
+    if (m_ids.empty() || radius < 0)
+    {
+        return;
+    }
+    static thread_local std::vector<double> squared;
+    const double radiusSquared = radius * radius;
+    const int firstColumn = column((long) std::floor(x - radius));
+    const int lastColumn = column((long) std::ceil(x + radius));
+    const int firstRow = row((long) std::floor(y - radius));
+    const int lastRow = row((long) std::ceil(y + radius));
+    for (int gy = firstRow; gy <= lastRow; gy++)
+    {
+        const int begin = m_cellStart[gy * m_columns + firstColumn];
+        const int end = m_cellStart[gy * m_columns + lastColumn + 1];
+        squared.resize(end - begin);
+        Util::squaredDistancesFrom(x, y, m_cellXs.data() + begin, m_cellYs.data() + begin, end - begin, squared.data());
+        for (int c = begin; c < end; c++)
+        {
+            if (squared[c - begin] <= radiusSquared)
+            {
+                out.push_back(m_ids[c]);
+            }
+        }
+    }
+}
+
+}//cvrp namespace
@@ -0,0 +1,46 @@
+#ifndef CVRP_SPATIAL_GRID
+#define CVRP_SPATIAL_GRID
+
+#include "cvrp_util.h"
+
+namespace cvrp
+{
+/*
+ * Uniform bucket grid over client coordinates (IDs 1..n, the depot at
+ * index 0 is not indexed), sized for about two clients per cell.  Queries
+ * visit cells in rings of increasing distance, so the cost depends on the
+ * local density rather than on the number of clients.
+ */
+class SpatialGrid
+{
+    public:
+        SpatialGrid() : m_cellSize(1), m_columns(0), m_rows(0), m_minX(0), m_minY(0) {}
+
+        void build(Span<const int> xs, Span<const int> ys);
+
+        /* The k clients nearest to (x, y), nearest first, ties by ID; 'exclude' is skipped */
+        void nearest(int x, int y, int k, std::vector<int>& out, int exclude = -1) const;
+        /* All clients within 'radius' of (x, y), in no particular order */
+        void withinRadius(int x, int y, double radius, std::vector<int>& out) const;
+
+    private:
+        /* Client IDs and their coordinates grouped by cell; cell c owns [m_cellStart[c], m_cellStart[c+1]) */
+        std::vector<int> m_cellStart;
+        std::vector<int> m_ids;
+        AlignedVector<int> m_cellXs;
+        AlignedVector<int> m_cellYs;
+        long m_cellSize;
+        int m_columns;
+        int m_rows;
+        int m_minX;
+        int m_minY;
+
+        int column(long x) const;
+        int row(long y) const;
+        /* Rank the clients of cells [firstCell, lastCell] of one row into best[0, found) */
+        void scanCells(int x, int y, int firstCell, int lastCell, int k, int exclude,
+                std::vector<std::pair<long, int>>& best, int& found) const;
+};
+
+}//cvrp namespace
+#endif
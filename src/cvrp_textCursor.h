@@ -0,0 +1,57 @@
+#ifndef CVRP_TEXT_CURSOR
+#define CVRP_TEXT_CURSOR
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace cvrp
+{
+/*
+ * Scans the text in place, tracking the line for error messages.  The
+ * readers' cursors build their grammars on it; the name and the text must
+ * outlive the cursor.
+ */
+class TextCursor
+{
+    public:
+        TextCursor(std::string_view text, const std::string& name) :
+            m_pos(text.data()), m_end(text.data() + text.size()), m_name(name), m_line(1) {}
+
+        bool atEnd() const { return m_pos == m_end; }
+
+        /* To just past the next newline, or to the end */
+        void nextLine()
+        {
+            while (!atEnd() && *m_pos != '\n')
+            {
+                m_pos++;
+            }
+            if (!atEnd())
+            {
+                m_pos++;
+                m_line++;
+            }
+        }
+
+        /* An invalid_argument naming the file and the current line */
+        [[noreturn]] void fail(const std::string& reason) const __attribute__((cold, noinline))
+        {
+            std::stringstream error;
+            error << m_name << ":" << m_line << ": " << reason;
+            throw std::invalid_argument(error.str());
+        }
+
+    protected:
+        const char *m_pos;
+        const char *m_end;
+        const std::string& m_name;
+        int m_line;
+
+        /* Steps over one character, counting the newlines */
+        void advance() { m_line += *m_pos++ == '\n'; }
+};
+
+}//cvrp namespace
+#endif
@@ -1,27 +1,86 @@
 #include "cvrp_util.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#ifdef __SSE2__
+#include <immintrin.h>
+#endif
+#ifdef _OPENMP
 #include <omp.h>
+#endif
 
 namespace cvrp
 {
 
-static std::vector<std::mt19937> prngs;
+/*
+ * One generator per thread rather than per OpenMP thread number, so that
+ * solves running concurrently on one team (batch mode) never share one.
+ * seed_prngs() bumps the generation; each thread reseeds on its next use.
+ */
+static std::atomic<unsigned long> prngGeneration(1);
+static std::atomic<unsigned long> prngSeed(0);
+static thread_local std::mt19937 threadPrng;
+static thread_local unsigned long threadPrngGeneration = 0;
+
+void Util::seed_prngs(unsigned long seed)
+{
+    prngSeed = seed;
+    prngGeneration++;
+}
 
-void Util::seed_prngs()
+std::mt19937& Util::get_prng()
 {
-    std::random_device rd;
-    prngs.resize(omp_get_num_procs());
-    for (auto& prng : prngs)
+    const unsigned long generation = prngGeneration.load(std::memory_order_relaxed);
+    if (threadPrngGeneration != generation)
     {
-        prng.seed(rd());
+        const unsigned long seed = prngSeed.load(std::memory_order_relaxed);
+        if (seed != 0)
+        {
+#ifdef _OPENMP
+            std::seed_seq sequence{ seed, static_cast<unsigned long>(omp_get_thread_num()) };
+#else
+            std::seed_seq sequence{ seed, 0ul };
+#endif
+            threadPrng.seed(sequence);
+        }
+        else
+        {
+            std::random_device rd;
+            threadPrng.seed(rd());
+        }
+        threadPrngGeneration = generation;
     }
+    return threadPrng;
 }
 
-std::mt19937& Util::get_prng()
+std::vector<uint32_t> Util::save_prng()
+{
+    std::stringstream text;
+    text << get_prng();
+    std::vector<uint32_t> state;
+    for (unsigned long word; text >> word;)
+    {
+        state.push_back(word);
+    }
+    return state;
+}
+
+void Util::restore_prng(const std::vector<uint32_t>& state)
 {
-    return prngs[omp_get_thread_num()];
+    std::stringstream text;
+    for (const uint32_t word : state)
+    {
+        text << word << ' ';
+    }
+    get_prng();
+    if (!(text >> threadPrng))
+    {
+        throw std::invalid_argument("Invalid generator state");
+    }
 }
 
 double Util::distance(int x1, int y1, int x2, int y2)
@@ -31,7 +90,98 @@ double Util::distance(int x1, int y1, int x2, int y2)
     return std::sqrt(dx*dx + dy*dy);
 }
 
-void Util::splitAndCascade(std::vector<int>& first, std::vector<int>& second, int splitPoint)
+/*
+ * Coordinates are converted to double before subtracting, so for
+ * coordinates below 2^26 every squared distance is exact and the results
+ * match Util::distance bit for bit.
+ */
+template <bool Root>
+static void distanceBatch(int x, int y, const int *xs, const int *ys, size_t count, double *out)
+{
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256d px = _mm256_set1_pd(x);
+    const __m256d py = _mm256_set1_pd(y);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m256d dx = _mm256_sub_pd(_mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i *>(xs + i))), px);
+        __m256d dy = _mm256_sub_pd(_mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i *>(ys + i))), py);
+        __m256d d = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+        _mm256_storeu_pd(out + i, Root ? _mm256_sqrt_pd(d) : d);
+    }
+#elif defined(__SSE2__)
+    const __m128d px = _mm_set1_pd(x);
+    const __m128d py = _mm_set1_pd(y);
+    for (; i + 2 <= count; i += 2)
+    {
+        __m128d dx = _mm_sub_pd(_mm_cvtepi32_pd(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(xs + i))), px);
+        __m128d dy = _mm_sub_pd(_mm_cvtepi32_pd(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(ys + i))), py);
+        __m128d d = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+        _mm_storeu_pd(out + i, Root ? _mm_sqrt_pd(d) : d);
+    }
+#endif
+    for (; i < count; i++)
+    {
+        double dx = (double) xs[i] - x;
+        double dy = (double) ys[i] - y;
+        out[i] = Root ? std::sqrt(dx*dx + dy*dy) : dx*dx + dy*dy;
+    }
+}
+
+static double minimumOf(const double *values, size_t count)
+{
+    size_t i = 0;
+    double best = std::numeric_limits<double>::infinity();
+#if defined(__AVX2__)
+    if (count >= 4)
+    {
+        __m256d m = _mm256_loadu_pd(values);
+        for (i = 4; i + 4 <= count; i += 4)
+        {
+            m = _mm256_min_pd(m, _mm256_loadu_pd(values + i));
+        }
+        __m128d h = _mm_min_pd(_mm256_castpd256_pd128(m), _mm256_extractf128_pd(m, 1));
+        best = _mm_cvtsd_f64(_mm_min_sd(h, _mm_unpackhi_pd(h, h)));
+    }
+#endif
+    for (; i < count; i++)
+    {
+        best = std::min(best, values[i]);
+    }
+    return best;
+}
+
+void Util::distancesFrom(int x, int y, const int *xs, const int *ys, size_t count, double *out)
+{
+    distanceBatch<true>(x, y, xs, ys, count, out);
+}
+
+void Util::squaredDistancesFrom(int x, int y, const int *xs, const int *ys, size_t count, double *out)
+{
+    distanceBatch<false>(x, y, xs, ys, count, out);
+}
+
+size_t Util::nearestOf(int x, int y, const int *xs, const int *ys, size_t count)
+{
+    constexpr size_t chunk = 64;
+    double squared[chunk];
+    double best = std::numeric_limits<double>::infinity();
+    size_t bestIndex = 0;
+    for (size_t base = 0; base < count; base += chunk)
+    {
+        const size_t n = std::min(chunk, count - base);
+        distanceBatch<false>(x, y, xs + base, ys + base, n, squared);
+        const double m = minimumOf(squared, n);
+        if (m < best)
+        {
+            best = m;
+            bestIndex = base + (std::find(squared, squared + n, m) - squared);
+        }
+    }
+    return bestIndex;
+}
+
+void Util::splitAndCascade(ClientSequence& first, ClientSequence& second, int splitPoint)
 {
     static thread_local std::vector<int> firstSplit;
     static thread_local std::vector<int> secondSplit;
@@ -49,7 +199,7 @@ void Util::splitAndCascade(std::vector<int>& first, std::vector<int>& second, in
     second.insert(second.end(), firstSplit.begin(), firstSplit.end());
 }
 
-void Util::splitAndFlipCascade(std::vector<int>& first, std::vector<int>& second, int splitPoint)
+void Util::splitAndFlipCascade(ClientSequence& first, ClientSequence& second, int splitPoint)
 {
     static thread_local std::vector<int> firstSplit;
     static thread_local std::vector<int> secondSplit;
@@ -3,18 +3,91 @@
 
 #include <vector>
 #include <random>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include "cvrp_idataModel.h"
+#include "cvrp_smallVector.h"
 
 namespace cvrp
 {
+/* A trip's clients in visiting order; trips rarely outgrow the inline part, so copying one seldom allocates */
+typedef SmallVector<int, 16> ClientSequence;
+
 class Util
 {
     public:
-        static void seed_prngs();
+        /* Every thread reseeds on its next use, from seed and its OpenMP thread number unless seed is 0 */
+        static void seed_prngs(unsigned long seed = 0);
         static std::mt19937& get_prng();
+        /* The calling thread's generator state, and putting one back (checkpoints) */
+        static std::vector<uint32_t> save_prng();
+        static void restore_prng(const std::vector<uint32_t>& state);
         static double distance(int x1, int y1, int x2, int y2);
-        static void splitAndCascade(std::vector<int>& first, std::vector<int>& second, int splitpoint);
-        static void splitAndFlipCascade(std::vector<int>& first, std::vector<int>& second, int splitPoint);
+        /* A distance as an edge cost, rounded half up when building with ROUNDED=y */
+#ifdef CVRP_ROUNDED_DISTANCES
+        static Cost toCost(double distance) { return static_cast<Cost>(distance + 0.5); }
+#else
+        static Cost toCost(double distance) { return distance; }
+#endif
+        /* Batch kernels (AVX2, SSE2 or scalar, by target) from (x, y) to count points */
+        static void distancesFrom(int x, int y, const int *xs, const int *ys, size_t count, double *out);
+        static void squaredDistancesFrom(int x, int y, const int *xs, const int *ys, size_t count, double *out);
+        /* Index of the first of the count points nearest to (x, y), 0 if count is 0 */
+        static size_t nearestOf(int x, int y, const int *xs, const int *ys, size_t count);
+        /* SplitMix64 finaliser: a well mixed 64-bit key from any 64-bit value */
+        static uint64_t splitmix64(uint64_t value)
+        {
+            value += 0x9e3779b97f4a7c15ull;
+            value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+            value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+            return value ^ (value >> 31);
+        }
+        static void splitAndCascade(ClientSequence& first, ClientSequence& second, int splitpoint);
+        static void splitAndFlipCascade(ClientSequence& first, ClientSequence& second, int splitPoint);
+};
+
+/* Non-owning view over contiguous elements */
+template <typename T>
+class Span
+{
+    public:
+        Span() : m_data(nullptr), m_size(0) {}
+        Span(T *data, size_t size) : m_data(data), m_size(size) {}
+
+        T *data() const { return m_data; }
+        size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+        T *begin() const { return m_data; }
+        T *end() const { return m_data + m_size; }
+        T& operator [] (size_t i) const { return m_data[i]; }
+
+    private:
+        T *m_data;
+        size_t m_size;
 };
 
+/* Cache-line aligned allocator, so that SIMD loads over model arrays never split lines */
+template <typename T, size_t Alignment = 64>
+struct AlignedAllocator
+{
+    typedef T value_type;
+    template <typename U> struct rebind { typedef AlignedAllocator<U, Alignment> other; };
+
+    AlignedAllocator() {}
+    template <typename U> AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+    T *allocate(size_t n)
+        { return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t(Alignment))); }
+    void deallocate(T *p, size_t)
+        { ::operator delete(p, std::align_val_t(Alignment)); }
+
+    template <typename U> bool operator == (const AlignedAllocator<U, Alignment>&) const { return true; }
+    template <typename U> bool operator != (const AlignedAllocator<U, Alignment>&) const { return false; }
+};
+
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
 }//cvrp namespace
 #endif
@@ -1,33 +1,42 @@
 #include "cvrp_vehicleTrip.h"
 #include "cvrp_util.h"
 
-#include <sstream>
+#include <charconv>
 
 namespace cvrp
 {
 
-VehicleTrip::VehicleTrip(const IDataModel& model) : m_model(&model)
+VehicleTrip::VehicleTrip(const IDataModel& model) : m_model(&model.view())
 {
     m_demandCovered = 0;
-    m_cost = 0.0;
+    m_cost = 0;
+    m_hash = 0;
 }
 
 std::string VehicleTrip::getTripStr() const
 {
-    std::stringstream stream;
-    stream << "x->";
-    for (std::vector<int>::const_iterator ite = m_clientSequence.begin();
+    std::string trip;
+    appendTripStr(trip);
+    return trip;
+}
+
+void VehicleTrip::appendTripStr(std::string& out) const
+{
+    char digits[16];
+    out += "x->";
+    for (ClientSequence::const_iterator ite = m_clientSequence.begin();
                 ite != m_clientSequence.end(); ++ite)
     {
-        stream << *ite << "->";
+        out.append(digits, std::to_chars(digits, digits + sizeof(digits), *ite).ptr);
+        out += "->";
     }
-    stream << "x ------- " << m_demandCovered;
-    return stream.str();
+    out += "x ------- ";
+    out.append(digits, std::to_chars(digits, digits + sizeof(digits), m_demandCovered).ptr);
 }
 
 bool VehicleTrip::canAccommodate(int clientId) const
 {
-    return ((m_model->getClientDemand(clientId) + m_demandCovered) <= m_model->vehicleCapacity());
+    return ((m_model->demand(clientId) + m_demandCovered) <= m_model->vehicleCapacity());
 }
 
 bool VehicleTrip::isValidTrip() const
@@ -35,81 +44,125 @@ bool VehicleTrip::isValidTrip() const
     return m_demandCovered <= m_model->vehicleCapacity();
 }
 
+void VehicleTrip::renumber(const IDataModel& model, const std::vector<int>& newIds)
+{
+    m_model = &model.view();
+    for (auto& clientId : m_clientSequence)
+    {
+        clientId = newIds[clientId];
+    }
+    m_hash = calcHash();
+    /* The prefixes' edge keys name the old IDs */
+    if (!m_prefix.empty())
+    {
+        updateSegments();
+    }
+}
+
 void VehicleTrip::addClientToTrip(int clientId)
 {
+    /* The closing edge from the old last client becomes two edges through the new one */
+    const int last = m_clientSequence.empty() ? 0 : m_clientSequence.back();
+    if (last != 0)
+    {
+        m_hash ^= edgeKey(0, last);
+    }
+    m_hash ^= edgeKey(clientId, last) ^ edgeKey(0, clientId);
     m_clientSequence.push_back(clientId);
-    m_demandCovered += m_model->getClientDemand(clientId);
+    m_demandCovered += m_model->demand(clientId);
 }
 
-void VehicleTrip::reEvaluateDemandAndCost()
+void VehicleTrip::reEvaluateDemandAndCost(RouteOptimiser optimiser)
 {
     m_demandCovered = 0;
     for (auto i : m_clientSequence)
     {
-        m_demandCovered += m_model->getClientDemand(i);
+        m_demandCovered += m_model->demand(i);
     }
-    optimiseCost();
+    optimiseCost(optimiser);
 }
 
-size_t VehicleTrip::calcHash() const
+void VehicleTrip::reEvaluateInOrder()
 {
-    size_t ret = 1;
-    for (auto x : m_clientSequence)
+    updateSegments();
+    m_demandCovered = m_prefix.back().load;
+    m_cost = m_prefix.back().distance + (m_clientSequence.empty() ? 0 : m_model->distance(m_clientSequence.back(), 0));
+    m_hash = m_clientSequence.empty() ? 0 : m_prefix.back().hash ^ edgeKey(0, m_clientSequence.back());
+}
+
+void VehicleTrip::updateSegments()
+{
+    m_prefix.resize(m_clientSequence.size() + 1);
+    m_prefix[0] = Prefix{ 0, 0, 0 };
+    int previous = 0;
+    for (size_t i = 0; i < m_clientSequence.size(); i++)
     {
-        ret++;
-		if (!x)
-		{
-			x = 1;
-		}
-        ret *= x;
-        ret ^= x*x;
+        const int clientId = m_clientSequence[i];
+        m_prefix[i + 1].load = m_prefix[i].load + m_model->demand(clientId);
+        m_prefix[i + 1].distance = m_prefix[i].distance + m_model->distance(previous, clientId);
+        m_prefix[i + 1].hash = m_prefix[i].hash ^ edgeKey(clientId, previous);
+        previous = clientId;
     }
-    return ret;
 }
 
-void VehicleTrip::optimiseCost()
+uint64_t VehicleTrip::calcHash() const
 {
-    m_cost = 0;
-    for (unsigned int i = 0; i < m_clientSequence.size(); i++)
+    if (m_clientSequence.empty())
     {
-        unsigned int nearestClientIndex = i;
-        double leastCost;
-        if (i == 0)
-        {
-            leastCost = m_model->getClientDistanceFromDepot(m_clientSequence[i]);
-        }
-        else
-        {
-            leastCost = m_model->distanceBetweenClients(m_clientSequence[i-1], m_clientSequence[i]);
-        }
-        for (unsigned int j = i+1; j < m_clientSequence.size(); j++)
-        {
-            m_hash *= m_clientSequence[j];
-            double currCost;
-            if (i==0)
-            {
-                currCost = m_model->getClientDistanceFromDepot(m_clientSequence[j]);
-            }
-            else
-            {
-                currCost = m_model->distanceBetweenClients(m_clientSequence[i-1], m_clientSequence[j]);
-            }
-
-            if (currCost < leastCost)
-            {
-                leastCost = currCost;
-                nearestClientIndex = j;
-            }
-        }
+        return 0;
+    }
+    uint64_t hash = 0;
+    int previous = 0;
+    for (const int clientId : m_clientSequence)
+    {
+        hash ^= edgeKey(clientId, previous);
+        previous = clientId;
+    }
+    return hash ^ edgeKey(0, previous);
+}
+
+void VehicleTrip::optimiseCost(RouteOptimiser optimiser)
+{
+    /* Route coordinates, kept in step with m_clientSequence for the batch kernel */
+    static thread_local AlignedVector<int> xs;
+    static thread_local AlignedVector<int> ys;
+    const size_t size = m_clientSequence.size();
+    xs.resize(size);
+    ys.resize(size);
+    for (size_t i = 0; i < size; i++)
+    {
+        xs[i] = m_model->x(m_clientSequence[i]);
+        ys[i] = m_model->y(m_clientSequence[i]);
+    }
 
+    m_cost = 0;
+    m_hash = 0;
+    int previous = 0;
+    for (size_t i = 0; i < size; i++)
+    {
+        size_t nearestClientIndex = i + Util::nearestOf(m_model->x(previous), m_model->y(previous),
+                xs.data() + i, ys.data() + i, size - i);
         if (nearestClientIndex != i)
         {
             std::swap(m_clientSequence[i], m_clientSequence[nearestClientIndex]);
+            std::swap(xs[i], xs[nearestClientIndex]);
+            std::swap(ys[i], ys[nearestClientIndex]);
         }
-        m_cost += leastCost;
+        m_cost += m_model->distance(previous, m_clientSequence[i]);
+        m_hash ^= edgeKey(m_clientSequence[i], previous);
+        previous = m_clientSequence[i];
+    }
+    m_cost += m_model->distance(previous, 0);
+    if (size > 0)
+    {
+        m_hash ^= edgeKey(0, previous);
+    }
+    if (optimiser != RouteOptimiser::Greedy)
+    {
+        m_cost = RouteSearch::improve(m_clientSequence, *m_model, optimiser, m_cost);
+        m_hash = calcHash();
     }
-    m_cost += m_model->getClientDistanceFromDepot(m_clientSequence.back());
-    m_hash = hash();
+    m_prefix.clear();
 }
 
 }//cvrp namespace
@@ -1,27 +1,71 @@
 #ifndef CVRP_VEHICLE_TRIP
 #define CVRP_VEHICLE_TRIP
 
+#include <cassert>
 #include "cvrp_idataModel.h"
+#include "cvrp_modelView.h"
+#include "cvrp_routeSearch.h"
 
 namespace cvrp
 {
+/* Consecutive clients of a trip, summarised; first and last are -1 when it is empty */
+struct RouteSegment
+{
+    int first;
+    int last;
+    int load;
+    /* Between first and last, the depot edges excluded */
+    Cost distance;
+    /* Edge keys between first and last, see VehicleTrip::edgeKey */
+    uint64_t hash;
+
+    bool empty() const { return first < 0; }
+};
+
 class VehicleTrip
 {
     public:
         VehicleTrip(const IDataModel& model);
 
-        double cost() const { return m_cost; }
+        Cost cost() const { return m_cost; }
         int demandCovered() const { return m_demandCovered; }
 
         bool canAccommodate(int clientId) const;
         void addClientToTrip(int clientId);
-        void optimiseCost();
-        void reEvaluateDemandAndCost();
+        /* Orders the clients greedily, then improves the order as the optimiser says */
+        void optimiseCost(RouteOptimiser optimiser = RouteOptimiser::Greedy);
+        void reEvaluateDemandAndCost(RouteOptimiser optimiser = RouteOptimiser::Greedy);
+        /* Demand, cost and segments of the clients in their current order, which is kept */
+        void reEvaluateInOrder();
         bool isValidTrip() const;
-        const std::vector<int>& clientSeqConst() const { return m_clientSequence; }
-        std::vector<int>& clientSequence() { return m_clientSequence; }
+        /* The same trip in a renumbered copy of its model; cost and load are kept, segments rebuilt if it had them */
+        void renumber(const IDataModel& model, const std::vector<int>& newIds);
+        const ClientSequence& clientSeqConst() const { return m_clientSequence; }
+        ClientSequence& clientSequence() { return m_clientSequence; }
         size_t getSeqSize() const { return m_clientSequence.size(); }
+        const ModelView& model() const { return *m_model; }
+
+        /*
+         * Prefix sums of load and distance for segment().  reEvaluateInOrder
+         * keeps them; optimiseCost drops them, so that the evolution, which
+         * never asks for segments, copies trips without them.
+         */
+        void updateSegments();
+        bool hasSegments() const { return m_prefix.size() == m_clientSequence.size() + 1; }
+        /* Clients [begin, end) in O(1); needs hasSegments() and, like cost(), goes stale with the sequence */
+        RouteSegment segment(size_t begin, size_t end) const
+        {
+            assert(hasSegments() && end <= getSeqSize());
+            if (begin >= end)
+            {
+                return RouteSegment{ -1, -1, 0, 0, 0 };
+            }
+            return RouteSegment{ m_clientSequence[begin], m_clientSequence[end - 1],
+                m_prefix[end].load - m_prefix[begin].load, m_prefix[end].distance - m_prefix[begin + 1].distance,
+                m_prefix[end].hash ^ m_prefix[begin + 1].hash };
+        }
         std::string getTripStr() const;
+        void appendTripStr(std::string& out) const;
 
         bool operator == (const VehicleTrip& other) const
             { return m_clientSequence == other.m_clientSequence && m_model == other.m_model; }
@@ -29,15 +73,34 @@ class VehicleTrip
         bool operator < (const VehicleTrip& other) const
             { return m_clientSequence < other.m_clientSequence && m_model == other.m_model; }
 
-        size_t hash() const { return m_hash; }
+        /*
+         * Zobrist hash of the trip: the XOR of the keys of its edges, the
+         * depot's at both ends included, so one edit changes it in O(1).
+         * Maintained by addClientToTrip and every re-evaluation; like cost(),
+         * stale after a direct change to clientSequence().  Empty trips hash
+         * to 0.
+         */
+        uint64_t hash() const { return m_hash; }
+        /* Key of the edge into client from predecessor, 0 being the depot */
+        static uint64_t edgeKey(int client, int predecessor)
+            { return Util::splitmix64(static_cast<uint64_t>(static_cast<uint32_t>(client)) << 32 | static_cast<uint32_t>(predecessor)); }
 
     private:
-        std::vector<int> m_clientSequence;
-        double m_cost;
+        /* Load, distance and edge keys from the depot to the k-th client */
+        struct Prefix
+        {
+            int load;
+            Cost distance;
+            uint64_t hash;
+        };
+
+        ClientSequence m_clientSequence;
+        std::vector<Prefix> m_prefix;
+        Cost m_cost;
         int m_demandCovered;
-        const IDataModel *m_model;
-        size_t m_hash;
-        size_t calcHash() const;
+        const ModelView *m_model;
+        uint64_t m_hash;
+        uint64_t calcHash() const;
 };
 
 }//cvrp namespace
@@ -0,0 +1,293 @@
+#include "cvrp_vrpReader.h"
+#include "cvrp_textCursor.h"
+
+#include <climits>
+#include <stdexcept>
+#include <vector>
+
+namespace cvrp
+{
+
+namespace
+{
+/* TSPLIB keywords and numbers off a TextCursor */
+class Cursor : public TextCursor
+{
+    public:
+        Cursor(std::string_view text, const std::string& name) : TextCursor(text, name) {}
+
+        bool atEol() const { return atEnd() || *m_pos == '\n' || *m_pos == '\r'; }
+
+        void skipBlanks()
+        {
+            while (!atEnd() && (*m_pos == ' ' || *m_pos == '\t'))
+            {
+                m_pos++;
+            }
+        }
+
+        void skipWhitespace()
+        {
+            while (!atEnd() && (*m_pos == ' ' || *m_pos == '\t' || *m_pos == '\r' || *m_pos == '\n'))
+            {
+                advance();
+            }
+        }
+
+        /* A keyword, up to a blank, a colon or the end of the line */
+        std::string_view keyword()
+        {
+            const char *start = m_pos;
+            while (!atEol() && *m_pos != ' ' && *m_pos != '\t' && *m_pos != ':')
+            {
+                m_pos++;
+            }
+            return std::string_view(start, m_pos - start);
+        }
+
+        /* The value after an optional colon, trimmed, ending the line */
+        std::string_view value()
+        {
+            skipBlanks();
+            if (!atEnd() && *m_pos == ':')
+            {
+                m_pos++;
+                skipBlanks();
+            }
+            const char *start = m_pos;
+            while (!atEol())
+            {
+                m_pos++;
+            }
+            const char *end = m_pos;
+            while (end > start && (end[-1] == ' ' || end[-1] == '\t'))
+            {
+                end--;
+            }
+            nextLine();
+            return std::string_view(start, end - start);
+        }
+
+        /* The next whitespace separated integer; "12.000" is accepted, "12.5" and "1e3" are not */
+        int integer(const char *what)
+        {
+            skipWhitespace();
+            const bool negative = !atEnd() && *m_pos == '-';
+            if (negative || (!atEnd() && *m_pos == '+'))
+            {
+                m_pos++;
+            }
+            if (atEnd() || *m_pos < '0' || *m_pos > '9')
+            {
+                fail(std::string("expected an integer for ") + what);
+            }
+            long value = 0;
+            while (!atEnd() && *m_pos >= '0' && *m_pos <= '9')
+            {
+                value = value * 10 + (*m_pos++ - '0');
+                if (value > INT_MAX)
+                {
+                    fail(std::string("integer out of range for ") + what);
+                }
+            }
+            if (!atEnd() && *m_pos == '.')
+            {
+                m_pos++;
+                while (!atEnd() && *m_pos == '0')
+                {
+                    m_pos++;
+                }
+                if (!atEnd() && *m_pos >= '1' && *m_pos <= '9')
+                {
+                    fail(std::string("non-integral value for ") + what);
+                }
+            }
+            if (!atEnd() && *m_pos != ' ' && *m_pos != '\t' && *m_pos != '\r' && *m_pos != '\n')
+            {
+                fail(std::string("malformed number for ") + what);
+            }
+            return negative ? -value : value;
+        }
+};
+
+int positive(Cursor& cursor, std::string_view value, const char *what)
+{
+    int result = 0;
+    for (char c : value)
+    {
+        if (c < '0' || c > '9' || result > (INT_MAX - 9) / 10)
+        {
+            cursor.fail(std::string("bad ") + what + ": " + std::string(value));
+        }
+        result = result * 10 + (c - '0');
+    }
+    if (value.empty() || result <= 0)
+    {
+        cursor.fail(std::string("bad ") + what + ": " + std::string(value));
+    }
+    return result;
+}
+}
+
+bool VrpReader::isVrp(std::string_view text)
+{
+    for (char c : text)
+    {
+        if (c != ' ' && c != '\t' && c != '\r' && c != '\n')
+        {
+            return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+        }
+    }
+    return false;
+}
+
+InstanceData VrpReader::parse(std::string_view text, const std::string& name)
+{
+    Cursor cursor(text, name);
+    int dimension = 0;
+    int capacity = -1;
+    std::vector<int> xs, ys, demands;
+    std::vector<char> hasCoords, hasDemand;
+    std::vector<int> depots;
+
+    while (!cursor.atEnd())
+    {
+        cursor.skipWhitespace();
+        const std::string_view key = cursor.keyword();
+        if (key.empty())
+        {
+            if (cursor.atEnd())
+            {
+                break;
+            }
+            cursor.fail("expected a keyword");
+        }
+        if (key == "EOF")
+        {
+            break;
+        }
+        if (key == "NODE_COORD_SECTION" || key == "DEMAND_SECTION")
+        {
+            if (dimension == 0)
+            {
+                cursor.fail(std::string(key) + " before DIMENSION");
+            }
+            const bool coords = key == "NODE_COORD_SECTION";
+            std::vector<char>& seen = coords ? hasCoords : hasDemand;
+            for (int i = 0; i < dimension; i++)
+            {
+                const int node = cursor.integer("node number");
+                if (node < 1 || node > dimension || seen[node - 1])
+                {
+                    cursor.fail("bad or repeated node number " + std::to_string(node));
+                }
+                seen[node - 1] = 1;
+                if (coords)
+                {
+                    xs[node - 1] = cursor.integer("x coordinate");
+                    ys[node - 1] = cursor.integer("y coordinate");
+                    if (xs[node - 1] < 0 || ys[node - 1] < 0)
+                    {
+                        cursor.fail("negative coordinate for node " + std::to_string(node));
+                    }
+                }
+                else
+                {
+                    demands[node - 1] = cursor.integer("demand");
+                    if (demands[node - 1] < 0)
+                    {
+                        cursor.fail("negative demand for node " + std::to_string(node));
+                    }
+                }
+            }
+            cursor.nextLine();
+        }
+        else if (key == "DEPOT_SECTION")
+        {
+            for (int node = cursor.integer("depot"); node != -1; node = cursor.integer("depot"))
+            {
+                if (node < 1 || node > dimension)
+                {
+                    cursor.fail("bad depot " + std::to_string(node));
+                }
+                depots.push_back(node);
+            }
+            cursor.nextLine();
+        }
+        else if (key.size() > 8 && key.substr(key.size() - 8) == "_SECTION")
+        {
+            cursor.fail("unsupported section " + std::string(key));
+        }
+        else
+        {
+            const std::string_view value = cursor.value();
+            if (key == "DIMENSION")
+            {
+                if (dimension != 0)
+                {
+                    cursor.fail("repeated DIMENSION");
+                }
+                dimension = positive(cursor, value, "DIMENSION");
+                xs.assign(dimension, 0);
+                ys.assign(dimension, 0);
+                demands.assign(dimension, 0);
+                hasCoords.assign(dimension, 0);
+                hasDemand.assign(dimension, 0);
+            }
+            else if (key == "CAPACITY")
+            {
+                capacity = positive(cursor, value, "CAPACITY");
+            }
+            else if (key == "EDGE_WEIGHT_TYPE" && value != "EUC_2D")
+            {
+                cursor.fail("unsupported EDGE_WEIGHT_TYPE " + std::string(value));
+            }
+            else if (key == "TYPE" && value != "CVRP")
+            {
+                cursor.fail("unsupported TYPE " + std::string(value));
+            }
+        }
+    }
+
+    if (dimension == 0 || capacity < 0)
+    {
+        cursor.fail("DIMENSION and CAPACITY are required");
+    }
+    if (depots.size() != 1)
+    {
+        cursor.fail("exactly one depot is supported, found " + std::to_string(depots.size()));
+    }
+    for (int i = 0; i < dimension; i++)
+    {
+        if (!hasCoords[i] || !hasDemand[i])
+        {
+            cursor.fail("missing coordinates or demand for node " + std::to_string(i + 1));
+        }
+    }
+    const int depot = depots[0] - 1;
+    if (demands[depot] != 0)
+    {
+        cursor.fail("the depot has a demand");
+    }
+
+    InstanceData data;
+    data.vehicleCapacity = capacity;
+    data.xs.reserve(dimension);
+    data.ys.reserve(dimension);
+    data.demands.reserve(dimension);
+    data.xs.push_back(xs[depot]);
+    data.ys.push_back(ys[depot]);
+    data.demands.push_back(0);
+    for (int i = 0; i < dimension; i++)
+    {
+        if (i != depot)
+        {
+            data.xs.push_back(xs[i]);
+            data.ys.push_back(ys[i]);
+            data.demands.push_back(demands[i]);
+        }
+    }
+    return data;
+}
+
+}//cvrp namespace
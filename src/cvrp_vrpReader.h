@@ -0,0 +1,25 @@
+#ifndef CVRP_VRP_READER
+#define CVRP_VRP_READER
+
+#include <string>
+#include <string_view>
+#include "cvrp_dataModel.h"
+
+namespace cvrp
+{
+/*
+ * Single pass reader for CVRPLIB / TSPLIB .vrp instances with EUC_2D
+ * weights, straight into InstanceData.  The DEPOT_SECTION node becomes
+ * index 0 and the other nodes keep their file order as clients 1..n.
+ * Coordinates must be non-negative integers, as in the JSON format.
+ */
+class VrpReader
+{
+    public:
+        static InstanceData parse(std::string_view text, const std::string& name);
+        /* True when the text starts with a specification keyword rather than JSON */
+        static bool isVrp(std::string_view text);
+};
+
+}//cvrp namespace
+#endif
@@ -1,30 +1,191 @@
 #include <iostream>
-#include <sstream>
-#include <fstream>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+#include <cstring>
+#include "cvrp_batch.h"
 #include "cvrp_dataModel.h"
+#include "cvrp_inputFile.h"
+#include "cvrp_lazyDataModel.h"
+#include "cvrp_server.h"
 #include "cvrp_solutionModel.h"
+#include "cvrp_solutionReader.h"
 #include "cvrp_solutionFinder.h"
+#include "cvrp_solutionWriter.h"
 #include "cvrp_util.h"
 
 using namespace cvrp;
 
+/*
+ * POPULATION, GENERATIONS, MUTATIONS (per generation), TIME_LIMIT (seconds) and SEED override the
+ * budget; CHECKPOINT names a file to save the state to every CHECKPOINT_INTERVAL seconds, RESUME one
+ * to carry on from
+ */
+static EvolutionOptions evolutionOptions(EvolutionOptions evolution)
+{
+    evolution.progress = !getenv("HIDE_PROGRESS");
+    evolution.allGenerations = getenv("BENCH");
+    if (const char *population = getenv("POPULATION"))
+    {
+        evolution.initialPopulation = std::max(1l, atol(population));
+    }
+    if (const char *generations = getenv("GENERATIONS"))
+    {
+        evolution.maxGenerations = atol(generations);
+    }
+    if (const char *mutations = getenv("MUTATIONS"))
+    {
+        evolution.maxMutationsPerGeneration = std::max(1l, atol(mutations));
+    }
+    if (const char *timeLimit = getenv("TIME_LIMIT"))
+    {
+        evolution.timeLimit = atof(timeLimit);
+    }
+    if (const char *seed = getenv("SEED"))
+    {
+        evolution.seed = strtoul(seed, nullptr, 10);
+    }
+    if (const char *checkpoint = getenv("CHECKPOINT"))
+    {
+        evolution.checkpointPath = checkpoint;
+    }
+    if (const char *interval = getenv("CHECKPOINT_INTERVAL"))
+    {
+        evolution.checkpointInterval = atof(interval);
+    }
+    if (const char *resume = getenv("RESUME"))
+    {
+        evolution.resumePath = resume;
+    }
+    return evolution;
+}
+
+/* ROUTE_OPTIMISER orders every trip: greedy (the default), 2opt or local */
+static RouteOptimiser routeOptimiser()
+{
+    const char *name = getenv("ROUTE_OPTIMISER");
+    return name ? RouteSearch::parse(name) : RouteOptimiser::Greedy;
+}
+
+static int runBatch(const char *instances, const char *outputDirectory, const DataModelOptions& options, SolutionFormat format)
+{
+    BatchOptions batch;
+    batch.model = options;
+    batch.routes = routeOptimiser();
+    /* Batches are meant for many small instances, so each gets a much smaller default budget */
+    EvolutionOptions small;
+    small.initialPopulation = 1'000;
+    small.maxMutationsPerGeneration = 1'000'000;
+    batch.evolution = evolutionOptions(small);
+    batch.evolution.progress = false;
+    /* One checkpoint file cannot serve many instances */
+    batch.evolution.checkpointPath.clear();
+    batch.evolution.resumePath.clear();
+    batch.format = format;
+    batch.outputDirectory = outputDirectory;
+
+    const BatchResult result = Batch::run(Batch::listInstances(instances), batch);
+    fprintf(stderr, "Solved %zu instances (%zu failed) in %.3fs, %.1f instances/s\n", result.solved, result.failed,
+            result.seconds, result.seconds > 0 ? result.solved / result.seconds : 0.0);
+    return result.failed == 0 ? 0 : 1;
+}
+
+/* Without a socket path the requests come on stdin and the replies go to stdout */
+static int runServer(const char *socketPath, const DataModelOptions& options)
+{
+    ServerOptions server;
+    server.model = options;
+    server.evolution = evolutionOptions(EvolutionOptions());
+    server.routes = routeOptimiser();
+    server.evolution.checkpointPath.clear();
+    server.evolution.resumePath.clear();
+    if (const char *cacheSize = getenv("SERVER_CACHE"))
+    {
+        server.cacheSize = atol(cacheSize);
+    }
+    Server solver(server);
+    if (socketPath)
+    {
+        fprintf(stderr, "Serving on %s\n", socketPath);
+        solver.listen(socketPath);
+    }
+    else
+    {
+        solver.serve(STDIN_FILENO, STDOUT_FILENO);
+    }
+    return 0;
+}
+
 int main(int argc, char *argv[])
 {
-    if (argc != 2)
+    const bool batch = argc > 1 && strcmp(argv[1], "--batch") == 0;
+    const bool serve = argc > 1 && strcmp(argv[1], "--serve") == 0;
+    if (batch ? (argc != 3 && argc != 4) : serve ? argc > 3 : argc != 2)
     {
 	    throw std::runtime_error("Required parameter missing");
     }
-    std::ifstream dataFile(argv[1], std::ifstream::binary);
-    std::stringstream jsonStream;
-    jsonStream << dataFile.rdbuf();
-    DataModel model(jsonStream);
-    SolutionFinder solutionFinder(model);
+    DataModelOptions options;
+    if (const char *neighbourCount = getenv("NEIGHBOUR_COUNT"))
+    {
+        options.neighbourCount = atoi(neighbourCount);
+    }
+    if (const char *distanceStorage = getenv("DISTANCE_STORAGE"))
+    {
+        options.distanceStorage = DistanceMatrix::parseStorage(distanceStorage);
+    }
+    SolutionFormat format = SolutionFormat::Text;
+    if (const char *solutionFormat = getenv("SOLUTION_FORMAT"))
+    {
+        format = SolutionWriter::parseFormat(solutionFormat);
+    }
+    const bool lazy = options.distanceStorage == DistanceStorage::Cached;
+    if (lazy)
+    {
+        options.distanceStorage = DistanceStorage::Computed;
+    }
+    if (serve)
+    {
+        /* cvrp --serve [socket] */
+        return runServer(argc == 3 ? argv[2] : nullptr, options);
+    }
+    if (batch)
+    {
+        /* cvrp --batch <manifest|directory> [output directory] */
+        return runBatch(argv[2], argc == 4 ? argv[3] : ".", options, format);
+    }
 
-    SolutionModel solution = solutionFinder.solutionWithEvolution();
+    /* An instance path, or "-" to read it from stdin */
+    std::shared_ptr<const InputFile> dataFile = InputFile::open(argv[1]);
+    std::unique_ptr<DataModel> dataModel = DataModel::load(dataFile, options);
+    const DataModel& model = *dataModel;
+    std::unique_ptr<LazyDataModel> lazyModel;
+    if (lazy)
+    {
+        const char *cacheMb = getenv("DISTANCE_CACHE_MB");
+        lazyModel.reset(new LazyDataModel(model, (cacheMb ? atol(cacheMb) : 1024) << 20));
+    }
+    std::cerr << (lazy ? lazyModel->distances() : model.distances()).describe() << std::endl;
+    SolutionFinder solutionFinder(lazy ? static_cast<const IDataModel&>(*lazyModel) : model, routeOptimiser());
+
+    /* WARM_START names a file of prior solutions in the printed text format to start from */
+    std::vector<SolutionModel> start;
+    if (const char *warmStart = getenv("WARM_START"))
+    {
+        for (const auto& routes : SolutionReader::parse(InputFile::open(warmStart)->text(), warmStart))
+        {
+            start.push_back(solutionFinder.warmStart(routes));
+        }
+        std::cerr << "Starting from " << start.size() << " solutions of " << warmStart << std::endl;
+    }
+    SolutionModel solution = solutionFinder.solutionWithEvolution(evolutionOptions(EvolutionOptions()), start);
+    if (lazyModel)
+    {
+        std::cerr << "Distance row cache: " << lazyModel->cache().hits() << " hits, "
+            << lazyModel->cache().misses() << " misses" << std::endl;
+    }
 
-    solution.printSolution();
-    std::cout << "Total Cost: " << solution.getCost() << std::endl;
-    std::cout << "##################################################################" << std::endl;
+    SolutionWriter::write(STDOUT_FILENO, solution, format);
 
     return 0;
 }
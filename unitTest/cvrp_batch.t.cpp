@@ -0,0 +1,79 @@
+#include "gtest/gtest.h"
+#include "../src/cvrp_batch.h"
+#include "cvrp_testFixtures.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace cvrp;
+
+TEST(Batch, solvesEveryListedInstance)
+{
+    char directory[] = "/tmp/cvrpBatchXXXXXX";
+    ASSERT_NE(mkdtemp(directory), nullptr);
+    const std::string base(directory);
+    std::ofstream(base + "/a.json") << smallInstanceJson;
+    std::ofstream(base + "/b.json") << smallInstanceJson;
+    std::ofstream(base + "/broken.json") << "{\"vehicleCapacity\": -1}";
+    std::ofstream(base + "/notes.txt") << "ignored";
+    std::ofstream(base + "/manifest") << "# nightly\na.json\n\n  " << base << "/b.json\n";
+
+    EXPECT_EQ(Batch::listInstances(base),
+            std::vector<std::string>({base + "/a.json", base + "/b.json", base + "/broken.json"}));
+    EXPECT_EQ(Batch::listInstances(base + "/manifest"),
+            std::vector<std::string>({base + "/a.json", base + "/b.json"}));
+
+    const std::string output = base + "/out";
+    ASSERT_EQ(mkdir(output.c_str(), 0755), 0);
+    BatchOptions options;
+    options.evolution = smallBudget();
+    options.format = SolutionFormat::Json;
+    options.outputDirectory = output;
+    EXPECT_EQ(Batch::resultPath(base + "/a.json", options), output + "/a.json.solution.json");
+    EXPECT_NE(Batch::resultPath(base + "/a.json", options), Batch::resultPath(base + "/a.vrp", options));
+#ifdef _OPENMP
+    const int levels = omp_get_max_active_levels();
+    omp_set_max_active_levels(3);
+#endif
+    const BatchResult result = Batch::run(Batch::listInstances(base), options);
+    EXPECT_EQ(result.solved, 2u);
+    EXPECT_EQ(result.failed, 1u);
+#ifdef _OPENMP
+    EXPECT_EQ(omp_get_max_active_levels(), 3);
+    omp_set_max_active_levels(levels);
+#endif
+
+    for (const char *name : { "a", "b" })
+    {
+        std::ifstream solution(output + "/" + name + ".json.solution.json");
+        std::string line;
+        ASSERT_TRUE(std::getline(solution, line));
+        EXPECT_EQ(line.find("{\"cost\":"), 0u);
+    }
+    EXPECT_FALSE(std::ifstream(output + "/broken.json.solution.json"));
+
+    /* Results written next to the inputs leave them alone and are not listed as instances */
+    options.outputDirectory = base;
+    EXPECT_EQ(Batch::run({ base + "/a.json" }, options).solved, 1u);
+    std::stringstream input;
+    input << std::ifstream(base + "/a.json").rdbuf();
+    EXPECT_EQ(input.str(), smallInstanceJson);
+    EXPECT_EQ(Batch::listInstances(base).size(), 3u);
+
+    /* Two instances of the same file name cannot share a result */
+    ASSERT_EQ(mkdir((base + "/copy").c_str(), 0755), 0);
+    std::ofstream(base + "/copy/a.json") << smallInstanceJson;
+    options.outputDirectory = output;
+    const BatchResult clash = Batch::run({ base + "/a.json", base + "/copy/a.json" }, options);
+    EXPECT_EQ(clash.solved, 1u);
+    EXPECT_EQ(clash.failed, 1u);
+
+    system(("rm -rf " + base).c_str());
+}
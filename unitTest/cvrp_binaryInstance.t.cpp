@@ -0,0 +1,93 @@
+#include "gtest/gtest.h"
+#include "../src/cvrp_binaryInstance.h"
+#include "../src/cvrp_dataModel.h"
+#include "../src/cvrp_util.h"
+
+#include <cstdio>
+#include <fstream>
+#include <unistd.h>
+
+using namespace cvrp;
+
+namespace
+{
+const char *instanceJson = "{\"vehicleCapacity\": 220,\"depot\": {\"x\": 40, \"y\": 40},\"nodes\": [{\"x\": 22, \"y\": 22, \"demand\": 18},{\"x\": 36, \"y\": 26, \"demand\": 26},{\"x\": 21, \"y\": 45, \"demand\": 11},{\"x\": 45, \"y\": 35, \"demand\": 30},{\"x\": 55, \"y\": 20, \"demand\": 21},{\"x\": 33, \"y\": 34, \"demand\": 19}]}";
+
+std::string writeInstance(const DataModel& model, bool distances, bool neighbours)
+{
+    char path[] = "/tmp/cvrpBinaryInstanceXXXXXX";
+    close(mkstemp(path));
+    std::ofstream out(path, std::ofstream::binary | std::ofstream::trunc);
+    BinaryInstance::write(model, out, distances, neighbours);
+    return path;
+}
+}
+
+TEST(BinaryInstance, roundTrip)
+{
+    std::stringstream jsonData(instanceJson);
+    DataModelOptions options;
+    options.neighbourCount = 3;
+    DataModel model(jsonData, options);
+    const std::string path = writeInstance(model, true, true);
+    std::shared_ptr<const InputFile> file = InputFile::open(path);
+    remove(path.c_str());
+
+    ASSERT_TRUE(BinaryInstance::isBinary(*file));
+    BinaryInstance instance(file);
+    EXPECT_TRUE(instance.hasDistances());
+    EXPECT_TRUE(instance.hasNeighbours());
+    DataModel mapped(instance, options);
+
+    EXPECT_EQ(mapped.vehicleCapacity(), 220);
+    EXPECT_EQ(mapped.depot(), Coord(40, 40));
+    ASSERT_EQ(mapped.numberOfClients(), model.numberOfClients());
+    /* Used in place, not copied */
+    EXPECT_EQ(mapped.distances().rawData(), instance.distances());
+    EXPECT_EQ(mapped.neighbourLists().all().data(), instance.neighbours().data());
+    for (int i = 1; i <= model.numberOfClients(); i++)
+    {
+        EXPECT_EQ(mapped.getClientLocation(i), model.getClientLocation(i));
+        EXPECT_EQ(mapped.getClientDemand(i), model.getClientDemand(i));
+        EXPECT_EQ(mapped.getClientDistanceFromDepot(i), model.getClientDistanceFromDepot(i));
+        for (int j = 1; j <= model.numberOfClients(); j++)
+        {
+            EXPECT_EQ(mapped.distanceBetweenClients(i, j), model.distanceBetweenClients(i, j));
+        }
+        ASSERT_EQ(mapped.neighbours(i).size(), 3u);
+        for (int k = 0; k < 3; k++)
+        {
+            EXPECT_EQ(mapped.neighbours(i)[k], model.neighbours(i)[k]);
+        }
+    }
+}
+
+TEST(BinaryInstance, rebuildsWhatDoesNotFit)
+{
+    std::stringstream jsonData(instanceJson);
+    DataModel model(jsonData);
+    const std::string path = writeInstance(model, false, true);
+    std::shared_ptr<const InputFile> file = InputFile::open(path);
+    remove(path.c_str());
+
+    BinaryInstance instance(file);
+    EXPECT_FALSE(instance.hasDistances());
+    DataModelOptions options;
+    options.neighbourCount = 2;
+    DataModel mapped(instance, options);
+    EXPECT_EQ(mapped.neighbourLists().count(), 2);
+    EXPECT_NE(mapped.neighbourLists().all().data(), instance.neighbours().data());
+    EXPECT_NEAR(mapped.distanceBetweenClients(1, 2), Util::toCost(14.5602), 0.001);
+}
+
+TEST(BinaryInstance, rejectsTruncatedFile)
+{
+    std::stringstream jsonData(instanceJson);
+    DataModel model(jsonData);
+    const std::string path = writeInstance(model, true, true);
+    ASSERT_EQ(truncate(path.c_str(), 200), 0);
+    std::shared_ptr<const InputFile> file = InputFile::open(path);
+    remove(path.c_str());
+
+    EXPECT_THROW(BinaryInstance instance(file), std::invalid_argument);
+}
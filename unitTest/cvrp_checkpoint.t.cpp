@@ -0,0 +1,99 @@
+#include "gtest/gtest.h"
+#include "../src/cvrp_checkpoint.h"
+#include "../src/cvrp_dataModel.h"
+#include "../src/cvrp_solutionFinder.h"
+#include "../src/cvrp_util.h"
+#include "cvrp_testFixtures.h"
+
+#include <cstdio>
+#include <sstream>
+#include <stdexcept>
+#include <unistd.h>
+
+using namespace cvrp;
+
+TEST(Checkpoint, roundTripsAndRejectsDamage)
+{
+    CheckpointState state;
+    state.fingerprint = 42;
+    state.generation = 7;
+    state.nullGenerations = 2;
+    state.population = { {{1, 2}, {3}}, {{3, 2, 1}} };
+    state.prngs = { Util::save_prng(), {} };
+
+    std::string data;
+    Checkpoint::encode(state, data);
+    const CheckpointState copy = Checkpoint::decode(data, "ckp");
+    EXPECT_EQ(copy.fingerprint, 42u);
+    EXPECT_EQ(copy.generation, 7u);
+    EXPECT_EQ(copy.nullGenerations, 2u);
+    EXPECT_EQ(copy.population, state.population);
+    EXPECT_EQ(copy.prngs, state.prngs);
+
+    EXPECT_THROW(Checkpoint::decode(data.substr(0, data.size() - 4), "ckp"), std::invalid_argument);
+    std::string flipped = data;
+    flipped[flipped.size() - 5] ^= 1;
+    EXPECT_THROW(Checkpoint::decode(flipped, "ckp"), std::invalid_argument);
+    EXPECT_THROW(Checkpoint::decode("CVRPBIN", "ckp"), std::invalid_argument);
+}
+
+TEST(Checkpoint, generatorStateRestores)
+{
+    const std::vector<uint32_t> saved = Util::save_prng();
+    const auto first = Util::get_prng()();
+    Util::restore_prng(saved);
+    EXPECT_EQ(Util::get_prng()(), first);
+}
+
+TEST(Checkpoint, evolutionResumesFromItsCheckpoint)
+{
+    char path[] = "/tmp/cvrpCheckpointXXXXXX";
+    const int fd = mkstemp(path);
+    ASSERT_GE(fd, 0);
+    close(fd);
+
+    std::stringstream json(smallInstanceJson);
+    DataModel model(json);
+    SolutionFinder finder(model);
+    EvolutionOptions options = smallBudget();
+    options.allGenerations = true;
+    options.checkpointPath = path;
+    const SolutionModel first = finder.solutionWithEvolution(options);
+
+    const CheckpointState state = Checkpoint::read(path);
+    EXPECT_EQ(state.fingerprint, Checkpoint::fingerprint(model.view()));
+    EXPECT_EQ(state.generation, 2u);
+    ASSERT_FALSE(state.population.empty());
+
+    options.maxGenerations = 3;
+    options.resumePath = path;
+    const SolutionModel resumed = finder.solutionWithEvolution(options);
+    EXPECT_TRUE(finder.validateSolution(resumed));
+    EXPECT_LE(resumed.getCost(), first.getCost());
+    EXPECT_EQ(Checkpoint::read(path).generation, 3u);
+
+    std::stringstream other("{\"vehicleCapacity\": 60,\"depot\": {\"x\": 40, \"y\": 40},\"nodes\": [{\"x\": 22, \"y\": 22, \"demand\": 18}]}");
+    DataModel otherModel(other);
+    EXPECT_THROW(SolutionFinder(otherModel).solutionWithEvolution(options), std::invalid_argument);
+    unlink(path);
+}
+
+TEST(Checkpoint, roundCutShortIsNotCounted)
+{
+    char path[] = "/tmp/cvrpCheckpointXXXXXX";
+    const int fd = mkstemp(path);
+    ASSERT_GE(fd, 0);
+    close(fd);
+
+    std::stringstream json(smallInstanceJson);
+    DataModel model(json);
+    SolutionFinder finder(model);
+    EvolutionOptions options = smallBudget();
+    options.allGenerations = true;
+    options.checkpointPath = path;
+    /* Out of time before the first round gets anywhere */
+    options.timeLimit = 1e-9;
+    EXPECT_TRUE(finder.validateSolution(finder.solutionWithEvolution(options)));
+    EXPECT_EQ(Checkpoint::read(path).generation, 0u);
+    unlink(path);
+}
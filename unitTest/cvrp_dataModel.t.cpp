@@ -1,5 +1,6 @@
 #include "gtest/gtest.h"
 #include "../src/cvrp_dataModel.h"
+#include "../src/cvrp_util.h"
 
 using namespace cvrp;
 
@@ -32,7 +33,7 @@ TEST(DataModel, distanceBetweenClients)
     EXPECT_EQ(model.vehicleCapacity(), 220);
     EXPECT_EQ(model.depot(), Coord(40, 40));
 
-    EXPECT_NEAR(model.distanceBetweenClients(1, 2), 14.5602, 0.001);
+    EXPECT_NEAR(model.distanceBetweenClients(1, 2), Util::toCost(14.5602), 0.001);
     EXPECT_THROW(model.distanceBetweenClients(1, 7), std::invalid_argument);
 
     EXPECT_EQ(model.getClientDemand(1), 18);
@@ -44,7 +45,62 @@ TEST(DataModel, distanceBetweenClients)
 
     EXPECT_EQ(model.numberOfClients(), 4);
 
-    EXPECT_NEAR(model.getClientDistanceFromDepot(1), 25.4558, 0.001);
-    EXPECT_NEAR(model.getClientDistanceFromDepot(4), 7.0710, 0.001);
+    EXPECT_NEAR(model.getClientDistanceFromDepot(1), Util::toCost(25.4558), 0.001);
+    EXPECT_NEAR(model.getClientDistanceFromDepot(4), Util::toCost(7.0710), 0.001);
+}
+
+TEST(DataModel, distanceMatrixIsSymmetric)
+{
+    std::stringstream jsonData;
+    jsonData << "{\"vehicleCapacity\": 220,\"depot\": {\"x\": 40, \"y\": 40},\"nodes\": [{\"x\": 22, \"y\": 22, \"demand\": 18},{\"x\": 36, \"y\": 26, \"demand\": 26},{\"x\": 21, \"y\": 45, \"demand\": 11},{\"x\": 45, \"y\": 35, \"demand\": 30}]}";
+    DataModel model(jsonData);
+
+    for (int i = 1; i <= model.numberOfClients(); i++)
+    {
+        EXPECT_EQ(model.distanceBetweenClients(i, i), 0.0);
+        for (int j = 1; j <= model.numberOfClients(); j++)
+        {
+            EXPECT_EQ(model.distanceBetweenClients(i, j), model.distanceBetweenClients(j, i));
+        }
+    }
+    EXPECT_NEAR(model.distanceBetweenClients(3, 4), 26.0, 0.001);
+}
+
+TEST(DataModel, clientArrays)
+{
+    std::stringstream jsonData;
+    jsonData << "{\"vehicleCapacity\": 220,\"depot\": {\"x\": 40, \"y\": 40},\"nodes\": [{\"x\": 22, \"y\": 22, \"demand\": 18},{\"x\": 36, \"y\": 26, \"demand\": 26},{\"x\": 21, \"y\": 45, \"demand\": 11},{\"x\": 45, \"y\": 35, \"demand\": 30}]}";
+    DataModel model(jsonData);
+
+    ASSERT_EQ(model.clientDemands().size(), 5);
+    EXPECT_EQ(model.clientDemands()[0], 0);
+    EXPECT_EQ(model.clientXs()[0], 40);
+    EXPECT_EQ(model.clientDemands()[2], 26);
+    EXPECT_EQ(model.clientXs()[3], 21);
+    EXPECT_EQ(model.clientYs()[3], 45);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(model.clientXs().data()) % 64, 0);
+}
+
+TEST(DataModel, viewMatchesCheckedApi)
+{
+    std::stringstream jsonData;
+    jsonData << "{\"vehicleCapacity\": 220,\"depot\": {\"x\": 40, \"y\": 40},\"nodes\": [{\"x\": 22, \"y\": 22, \"demand\": 18},{\"x\": 36, \"y\": 26, \"demand\": 26},{\"x\": 21, \"y\": 45, \"demand\": 11},{\"x\": 45, \"y\": 35, \"demand\": 30}]}";
+    DataModel model(jsonData);
+    ModelView snapshot(static_cast<const IDataModel&>(model));
+
+    EXPECT_EQ(model.view().vehicleCapacity(), 220);
+    EXPECT_EQ(model.view().numberOfClients(), 4);
+    EXPECT_EQ(snapshot.numberOfClients(), 4);
+    for (int i = 1; i <= 4; i++)
+    {
+        EXPECT_EQ(model.view().demand(i), model.getClientDemand(i));
+        EXPECT_EQ(snapshot.demand(i), model.getClientDemand(i));
+        EXPECT_EQ(model.view().distance(0, i), model.getClientDistanceFromDepot(i));
+        EXPECT_EQ(snapshot.distance(i, 0), model.getClientDistanceFromDepot(i));
+        for (int j = 1; j <= 4; j++)
+        {
+            EXPECT_EQ(snapshot.distance(i, j), model.view().distance(i, j));
+        }
+    }
 }
 
@@ -0,0 +1,56 @@
+#include "gtest/gtest.h"
+#include "../src/cvrp_distanceMatrix.h"
+#include "../src/cvrp_util.h"
+
+using namespace cvrp;
+
+TEST(DistanceMatrix, triangularMatchesDense)
+{
+    AlignedVector<int> xs = {40, 22, 36, 21, 45, 55};
+    AlignedVector<int> ys = {40, 22, 26, 45, 35, 20};
+    DistanceMatrix dense, triangular;
+    dense.build(Span<const int>(xs.data(), xs.size()), Span<const int>(ys.data(), ys.size()), DistanceStorage::Dense);
+    triangular.build(Span<const int>(xs.data(), xs.size()), Span<const int>(ys.data(), ys.size()), DistanceStorage::Triangular);
+
+    EXPECT_EQ(dense.storage(), DistanceStorage::Dense);
+    EXPECT_EQ(triangular.storage(), DistanceStorage::Triangular);
+    EXPECT_EQ(dense.memoryFootprint(), 36 * sizeof(DistanceMatrix::DenseDistance));
+    EXPECT_EQ(triangular.memoryFootprint(), 21 * sizeof(DistanceMatrix::PackedDistance));
+    for (int i = 0; i < 6; i++)
+    {
+        EXPECT_EQ(triangular(i, i), 0.0);
+        for (int j = 0; j < 6; j++)
+        {
+            EXPECT_NEAR(triangular(i, j), dense(i, j), 1e-4);
+            EXPECT_EQ(triangular(i, j), triangular(j, i));
+        }
+    }
+    EXPECT_NEAR(triangular(0, 1), Util::toCost(25.4558), 0.001);
+}
+
+TEST(DistanceMatrix, storageSelection)
+{
+    EXPECT_EQ(DistanceMatrix::resolve(DistanceStorage::Auto, 1000), DistanceStorage::Dense);
+    EXPECT_EQ(DistanceMatrix::resolve(DistanceStorage::Auto, 30000), DistanceStorage::Triangular);
+    EXPECT_EQ(DistanceMatrix::resolve(DistanceStorage::Dense, 30000), DistanceStorage::Dense);
+    EXPECT_EQ(DistanceMatrix::parseStorage("triangular"), DistanceStorage::Triangular);
+    EXPECT_THROW(DistanceMatrix::parseStorage("sparse"), std::invalid_argument);
+}
+
+#ifdef CVRP_ROUNDED_DISTANCES
+TEST(DistanceMatrix, roundedCosts)
+{
+    AlignedVector<int> xs = {40, 22, 36, 21};
+    AlignedVector<int> ys = {40, 22, 26, 45};
+    DistanceMatrix dense, triangular;
+    dense.build(Span<const int>(xs.data(), xs.size()), Span<const int>(ys.data(), ys.size()), DistanceStorage::Dense);
+    triangular.build(Span<const int>(xs.data(), xs.size()), Span<const int>(ys.data(), ys.size()), DistanceStorage::Triangular);
+
+    /* 25.4558, 14.5602 and 19.6469 rounded half up */
+    EXPECT_EQ(dense(0, 1), 25);
+    EXPECT_EQ(triangular(1, 0), 25);
+    EXPECT_EQ(dense(1, 2), 15);
+    EXPECT_EQ(triangular(3, 0), 20);
+    EXPECT_EQ(Util::toCost(2.5), 3);
+}
+#endif
@@ -0,0 +1,36 @@
+#include "gtest/gtest.h"
+#include "../src/cvrp_inputFile.h"
+
+#include <cstdio>
+#include <fstream>
+#include <unistd.h>
+
+using namespace cvrp;
+
+TEST(InputFile, mapsRegularFiles)
+{
+    char path[] = "/tmp/cvrpInputFileXXXXXX";
+    close(mkstemp(path));
+    std::ofstream(path) << "{\"vehicleCapacity\": 220}";
+    std::shared_ptr<const InputFile> file = InputFile::open(path);
+    remove(path);
+
+    EXPECT_TRUE(file->mapped());
+    EXPECT_EQ(file->text(), "{\"vehicleCapacity\": 220}");
+    EXPECT_THROW(InputFile::open(path), std::runtime_error);
+}
+
+TEST(InputFile, readsPipesIntoOneBuffer)
+{
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    const std::string chunk(1000, 'x');
+    ASSERT_EQ(write(fds[1], chunk.data(), chunk.size()), (ssize_t) chunk.size());
+    close(fds[1]);
+    std::shared_ptr<const InputFile> file = InputFile::read(fds[0], "<pipe>");
+    close(fds[0]);
+
+    EXPECT_FALSE(file->mapped());
+    EXPECT_EQ(file->path(), "<pipe>");
+    EXPECT_EQ(file->text(), chunk);
+}
@@ -0,0 +1,116 @@
+#include "gtest/gtest.h"
+#include "../src/cvrp_instanceDelta.h"
+#include "../src/cvrp_solutionFinder.h"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+using namespace cvrp;
+
+namespace
+{
+/* Two clusters far apart, so that a good solution keeps them on separate trips */
+const char *instanceJson = "{\"vehicleCapacity\": 50,\"depot\": {\"x\": 50, \"y\": 50},\"nodes\": ["
+    "{\"x\": 10, \"y\": 10, \"demand\": 10},{\"x\": 12, \"y\": 10, \"demand\": 10},{\"x\": 10, \"y\": 12, \"demand\": 10},"
+    "{\"x\": 90, \"y\": 90, \"demand\": 10},{\"x\": 92, \"y\": 90, \"demand\": 10},{\"x\": 90, \"y\": 92, \"demand\": 10}]}";
+}
+
+TEST(InstanceDelta, renumbersKeptClientsAndAppendsAddedOnes)
+{
+    std::stringstream json(instanceJson);
+    DataModel model(json);
+    InstanceDelta delta;
+    delta.removed = { 2 };
+    ClientChange modified;
+    modified.id = 4;
+    modified.x = 91;
+    modified.y = 91;
+    modified.demand = 25;
+    delta.modified = { modified };
+    ClientChange added;
+    added.x = 11;
+    added.y = 11;
+    added.demand = 5;
+    delta.added = { added };
+
+    std::vector<int> newIds;
+    std::unique_ptr<DataModel> edited = delta.apply(model, DataModelOptions(), newIds);
+    EXPECT_EQ(newIds, std::vector<int>({0, 1, 0, 2, 3, 4, 5}));
+    EXPECT_EQ(edited->numberOfClients(), 6);
+    EXPECT_EQ(edited->getClientDemand(3), 25);
+    EXPECT_EQ(edited->getClientLocation(6), Coord(11, 11));
+    EXPECT_EQ(delta.changedClients(newIds), std::vector<int>({3, 6}));
+
+    delta.removed = { 4 };
+    EXPECT_THROW(delta.apply(model, DataModelOptions(), newIds), std::invalid_argument);
+    delta.removed = { 7 };
+    EXPECT_THROW(delta.apply(model, DataModelOptions(), newIds), std::invalid_argument);
+}
+
+TEST(InstanceDelta, repairReusesUntouchedTrips)
+{
+    std::stringstream json(instanceJson);
+    DataModel model(json);
+    const SolutionModel previous = SolutionFinder(model).importSolution({{1, 2, 3}, {4, 5, 6}});
+
+    /* Client 5 is cancelled and a client joins the first cluster, with no trip having room for it */
+    InstanceDelta delta;
+    delta.removed = { 5 };
+    ClientChange added;
+    added.x = 11;
+    added.y = 11;
+    added.demand = 35;
+    delta.added = { added };
+    std::vector<int> newIds;
+    std::unique_ptr<DataModel> edited = delta.apply(model, DataModelOptions(), newIds);
+    SolutionFinder finder(*edited);
+    const SolutionModel repaired = finder.repair(previous, newIds, delta.changedClients(newIds), 0);
+
+    EXPECT_TRUE(finder.validateSolution(repaired));
+    EXPECT_TRUE(repaired.isFeasible());
+    ASSERT_EQ(repaired.chromosomesConst().size(), 3u);
+    /* The untouched trip keeps its cost as it was, only renumbered */
+    EXPECT_EQ(repaired.chromosomesConst()[0].clientSeqConst(), previous.chromosomesConst()[0].clientSeqConst());
+    EXPECT_EQ(repaired.chromosomesConst()[0].cost(), previous.chromosomesConst()[0].cost());
+    EXPECT_EQ(repaired.chromosomesConst()[1].demandCovered(), 20);
+    EXPECT_EQ(repaired.chromosomesConst()[2].clientSeqConst(), ClientSequence({6}));
+
+    EXPECT_TRUE(finder.validateSolution(finder.repair(previous, newIds, delta.changedClients(newIds))));
+}
+
+TEST(InstanceDelta, repairInsertsAtTheCheapestPosition)
+{
+    std::stringstream json(instanceJson);
+    DataModel model(json);
+    const SolutionModel previous = SolutionFinder(model).importSolution({{1, 2, 3}, {4, 5, 6}});
+
+    /* A client joins the second cluster, whose trip has room for it */
+    InstanceDelta delta;
+    ClientChange added;
+    added.x = 91;
+    added.y = 91;
+    added.demand = 10;
+    delta.added = { added };
+    std::vector<int> newIds;
+    std::unique_ptr<DataModel> edited = delta.apply(model, DataModelOptions(), newIds);
+    SolutionFinder finder(*edited);
+    const SolutionModel repaired = finder.repair(previous, newIds, delta.changedClients(newIds), 0);
+    ASSERT_EQ(repaired.chromosomesConst().size(), 2u);
+
+    /* The other clients keep their order and the trip costs the cheapest insertion */
+    const ModelView& view = edited->view();
+    const ClientSequence& before = previous.chromosomesConst()[1].clientSeqConst();
+    ClientSequence after = repaired.chromosomesConst()[1].clientSeqConst();
+    Cost cheapest = 0;
+    for (size_t i = 0; i <= before.size(); i++)
+    {
+        const int from = i == 0 ? 0 : before[i - 1];
+        const int to = i == before.size() ? 0 : before[i];
+        const Cost cost = view.distance(from, 7) + view.distance(7, to) - view.distance(from, to);
+        cheapest = i == 0 ? cost : std::min(cheapest, cost);
+    }
+    EXPECT_NEAR(repaired.chromosomesConst()[1].cost(), previous.chromosomesConst()[1].cost() + cheapest, 1e-6);
+    after.erase(std::find(after.begin(), after.end(), 7));
+    EXPECT_EQ(after, before);
+}
@@ -0,0 +1,36 @@
+#include "gtest/gtest.h"
+#include "../src/cvrp_jsonReader.h"
+
+using namespace cvrp;
+
+TEST(JsonReader, commentsAndUnknownKeys)
+{
+    const char *text =
+        "/* generated */ {\n"
+        "    \"name\": \"tiny\", \"tags\": [1, {\"a\": [true, false, null]}, \"x\\\"y\"],\n"
+        "    \"nodes\": [ // clients\n"
+        "        {\"x\": 22, \"y\": 22, \"demand\": 18, \"label\": \"first\"},\n"
+        "        {\"demand\": 26, \"y\": 26, \"x\": 36.0}\n"
+        "    ],\n"
+        "    \"depot\": {\"x\": 40, \"y\": 40}, // may follow the nodes\n"
+        "    \"vehicleCapacity\": 220\n"
+        "}\n";
+    InstanceData data = JsonReader::parse(text, "tiny.json");
+    EXPECT_EQ(data.vehicleCapacity, 220);
+    EXPECT_EQ(std::vector<int>(data.xs.begin(), data.xs.end()), std::vector<int>({40, 22, 36}));
+    EXPECT_EQ(std::vector<int>(data.ys.begin(), data.ys.end()), std::vector<int>({40, 22, 26}));
+    EXPECT_EQ(std::vector<int>(data.demands.begin(), data.demands.end()), std::vector<int>({0, 18, 26}));
+}
+
+TEST(JsonReader, invalidData)
+{
+    EXPECT_THROW(JsonReader::parse("{\"depot\": {\"x\": 1, \"y\": 1}, \"nodes\": []}", "t"), std::invalid_argument);
+    EXPECT_THROW(JsonReader::parse("{\"vehicleCapacity\": 9, \"depot\": {\"x\": 1}, \"nodes\": []}", "t"), std::invalid_argument);
+    EXPECT_THROW(JsonReader::parse("{\"vehicleCapacity\": 9, \"depot\": {\"x\": 1, \"y\": 1}, "
+                "\"nodes\": [{\"x\": 2.5, \"y\": 1, \"demand\": 1}]}", "t"), std::invalid_argument);
+    EXPECT_THROW(JsonReader::parse("{\"vehicleCapacity\": 9, \"depot\": {\"x\": 1, \"y\": 1}, "
+                "\"nodes\": [{\"x\": 2, \"y\": 1}]}", "t"), std::invalid_argument);
+    EXPECT_THROW(JsonReader::parse("{\"vehicleCapacity\": 9, \"depot\": {\"x\": 1, \"y\": 1}, \"nodes\": [", "t"),
+            std::invalid_argument);
+    EXPECT_THROW(JsonReader::parse("{\"vehicleCapacity\": 9 /* open", "t"), std::invalid_argument);
+}
@@ -0,0 +1,35 @@
+#include "gtest/gtest.h"
+#include "../src/cvrp_lazyDataModel.h"
+#include "../src/cvrp_util.h"
+
+using namespace cvrp;
+
+TEST(LazyDataModel, matchesDenseModel)
+{
+    std::stringstream jsonData;
+    jsonData << "{\"vehicleCapacity\": 220,\"depot\": {\"x\": 40, \"y\": 40},\"nodes\": [{\"x\": 22, \"y\": 22, \"demand\": 18},{\"x\": 36, \"y\": 26, \"demand\": 26},{\"x\": 21, \"y\": 45, \"demand\": 11},{\"x\": 45, \"y\": 35, \"demand\": 30}]}";
+    DataModelOptions options;
+    options.distanceStorage = DistanceStorage::Computed;
+    DataModel base(jsonData, options);
+    /* Room for two of the five rows */
+    LazyDataModel model(base, 2 * 5 * sizeof(double));
+
+    EXPECT_EQ(base.distances().storage(), DistanceStorage::Computed);
+    EXPECT_EQ(model.distances().storage(), DistanceStorage::Cached);
+    EXPECT_EQ(model.cache().capacityRows(), 2);
+    EXPECT_NEAR(model.distanceBetweenClients(1, 2), Util::toCost(14.5602), 0.001);
+    EXPECT_NEAR(model.getClientDistanceFromDepot(1), Util::toCost(25.4558), 0.001);
+    EXPECT_THROW(model.distanceBetweenClients(1, 7), std::invalid_argument);
+    EXPECT_EQ(model.getClientDemand(4), 30);
+
+    for (int i = 0; i <= 4; i++)
+    {
+        for (int j = 0; j <= 4; j++)
+        {
+            EXPECT_EQ(model.view().distance(i, j), base.view().distance(i, j));
+        }
+    }
+    EXPECT_LE(model.cache().residentRows(), 2);
+    EXPECT_GE(model.cache().misses(), 5);
+    EXPECT_GT(model.cache().hits(), 0);
+}
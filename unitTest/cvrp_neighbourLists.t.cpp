@@ -0,0 +1,38 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "../src/cvrp_neighbourLists.h"
+#include "../src/cvrp_dataModel.h"
+
+using ::testing::ElementsAre;
+using namespace cvrp;
+
+TEST(NeighbourLists, nearestFirst)
+{
+    std::stringstream jsonData;
+    jsonData << "{\"vehicleCapacity\": 220,\"depot\": {\"x\": 40, \"y\": 40},\"nodes\": [{\"x\": 22, \"y\": 22, \"demand\": 18},{\"x\": 36, \"y\": 26, \"demand\": 26},{\"x\": 21, \"y\": 45, \"demand\": 11},{\"x\": 45, \"y\": 35, \"demand\": 30}]}";
+    DataModelOptions options;
+    options.neighbourCount = 2;
+    DataModel model(jsonData, options);
+
+    EXPECT_THAT(std::vector<int>(model.neighbours(1).begin(), model.neighbours(1).end()), ElementsAre(2, 3));
+    EXPECT_THAT(std::vector<int>(model.neighbours(4).begin(), model.neighbours(4).end()), ElementsAre(2, 3));
+    EXPECT_THAT(std::vector<int>(model.view().neighbours(0).begin(), model.view().neighbours(0).end()), ElementsAre(4, 2));
+    EXPECT_THROW(model.neighbours(5), std::invalid_argument);
+}
+
+TEST(NeighbourLists, countIsClamped)
+{
+    AlignedVector<int> xs = {0, 1, 2, 3};
+    AlignedVector<int> ys = {0, 0, 0, 0};
+    Span<const int> xSpan(xs.data(), xs.size());
+    Span<const int> ySpan(ys.data(), ys.size());
+    SpatialGrid grid;
+    grid.build(xSpan, ySpan);
+    NeighbourLists lists;
+    lists.build(xSpan, ySpan, 10, grid);
+
+    EXPECT_EQ(lists.count(), 2);
+    EXPECT_THAT(std::vector<int>(lists.of(1).begin(), lists.of(1).end()), ElementsAre(2, 3));
+    EXPECT_THAT(std::vector<int>(lists.of(2).begin(), lists.of(2).end()), ElementsAre(1, 3));
+    EXPECT_THAT(std::vector<int>(lists.of(0).begin(), lists.of(0).end()), ElementsAre(1, 2));
+}
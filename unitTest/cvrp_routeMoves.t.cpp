@@ -0,0 +1,157 @@
+#include "gtest/gtest.h"
+#include "../src/cvrp_routeMoves.h"
+#include "../src/cvrp_dataModel.h"
+#include "../src/cvrp_instanceDelta.h"
+#include "../src/cvrp_solutionFinder.h"
+#include "cvrp_testFixtures.h"
+
+#include <sstream>
+
+using namespace cvrp;
+
+namespace
+{
+struct Recomputed
+{
+    Cost cost;
+    int load;
+    uint64_t hash;
+};
+
+/* Cost, load and hash of the trip's sequence from scratch, in its order */
+Recomputed recompute(const VehicleTrip& trip)
+{
+    const ModelView& model = trip.model();
+    Recomputed result{ 0, 0, 0 };
+    int previous = 0;
+    for (const int client : trip.clientSeqConst())
+    {
+        result.cost += model.distance(previous, client);
+        result.load += model.demand(client);
+        result.hash ^= VehicleTrip::edgeKey(client, previous);
+        previous = client;
+    }
+    if (previous != 0)
+    {
+        result.cost += model.distance(previous, 0);
+        result.hash ^= VehicleTrip::edgeKey(0, previous);
+    }
+    return result;
+}
+
+/* Every pair of positions, segment lengths up to two */
+template <typename Evaluate, typename Apply>
+void checkAgainstApplying(const VehicleTrip& a, const VehicleTrip& b, size_t extraA, size_t extraB,
+        Evaluate evaluate, Apply apply)
+{
+    for (size_t i = 0; i + extraA <= a.getSeqSize(); i++)
+    {
+        for (size_t j = 0; j + extraB <= b.getSeqSize(); j++)
+        {
+            const MoveEvaluation move = evaluate(a, i, b, j);
+            VehicleTrip newA = a;
+            VehicleTrip newB = b;
+            apply(newA, i, newB, j);
+            EXPECT_NEAR(move.delta, newA.cost() + newB.cost() - a.cost() - b.cost(), 1e-6) << i << " " << j;
+            EXPECT_EQ(move.feasible, newA.isValidTrip() && newB.isValidTrip()) << i << " " << j;
+            EXPECT_EQ(move.hash, a.hash() ^ b.hash() ^ newA.hash() ^ newB.hash()) << i << " " << j;
+            /* The applied trips are costed as they stand, not re-ordered, and keep their segments */
+            for (const VehicleTrip *trip : { &newA, &newB })
+            {
+                const Recomputed expected = recompute(*trip);
+                EXPECT_NEAR(trip->cost(), expected.cost, 1e-6) << i << " " << j;
+                EXPECT_EQ(trip->demandCovered(), expected.load) << i << " " << j;
+                EXPECT_EQ(trip->hash(), expected.hash) << i << " " << j;
+                ASSERT_TRUE(trip->hasSegments());
+                const RouteSegment whole = trip->segment(0, trip->getSeqSize());
+                EXPECT_EQ(whole.load, expected.load);
+                EXPECT_NEAR(RouteMoves::concatenate(trip->model(), { whole }), expected.cost, 1e-6);
+            }
+        }
+    }
+}
+}
+
+TEST(RouteMoves, segmentsSummarisePrefixes)
+{
+    std::stringstream json(eightClientInstanceJson);
+    DataModel model(json);
+    SolutionModel solution = SolutionFinder(model).importSolution({{1, 2, 3, 4}, {5, 6, 7, 8}});
+#ifndef NDEBUG
+    EXPECT_DEATH(solution.chromosomesConst()[0].segment(0, 1), "hasSegments");
+#endif
+    for (auto& trip : solution.chromosomes())
+    {
+        EXPECT_FALSE(trip.hasSegments());
+        trip.updateSegments();
+    }
+    const VehicleTrip& trip = solution.chromosomesConst()[0];
+    const auto& sequence = trip.clientSeqConst();
+
+    const RouteSegment whole = trip.segment(0, sequence.size());
+    EXPECT_EQ(whole.load, trip.demandCovered());
+    EXPECT_NEAR(RouteMoves::concatenate(model.view(), { whole }), trip.cost(), 1e-6);
+    const RouteSegment middle = trip.segment(1, 3);
+    EXPECT_EQ(middle.first, sequence[1]);
+    EXPECT_EQ(middle.last, sequence[2]);
+    EXPECT_EQ(middle.load, model.view().demand(sequence[1]) + model.view().demand(sequence[2]));
+    EXPECT_NEAR(middle.distance, model.view().distance(sequence[1], sequence[2]), 1e-6);
+    EXPECT_TRUE(trip.segment(2, 2).empty());
+    EXPECT_NEAR(RouteMoves::concatenate(model.view(), { trip.segment(0, 2), trip.segment(4, 4), trip.segment(2, 4) }),
+            trip.cost(), 1e-6);
+}
+
+TEST(RouteMoves, evaluationsMatchTheAppliedMoves)
+{
+    std::stringstream json(eightClientInstanceJson);
+    DataModel model(json);
+    SolutionModel solution = SolutionFinder(model).importSolution({{1, 2, 3, 4}, {5, 6, 7, 8}});
+    for (auto& trip : solution.chromosomes())
+    {
+        EXPECT_FALSE(trip.hasSegments());
+        trip.updateSegments();
+    }
+    const VehicleTrip& a = solution.chromosomesConst()[0];
+    const VehicleTrip& b = solution.chromosomesConst()[1];
+
+    checkAgainstApplying(a, b, 1, 0, RouteMoves::relocate,
+            [](VehicleTrip& x, size_t i, VehicleTrip& y, size_t j) { RouteMoves::applyCrossExchange(x, i, 1, y, j, 0); });
+    checkAgainstApplying(a, b, 1, 1, RouteMoves::swap,
+            [](VehicleTrip& x, size_t i, VehicleTrip& y, size_t j) { RouteMoves::applyCrossExchange(x, i, 1, y, j, 1); });
+    checkAgainstApplying(a, b, 0, 0, RouteMoves::twoOptStar, RouteMoves::applyTwoOptStar);
+    checkAgainstApplying(a, b, 2, 1,
+            [](const VehicleTrip& x, size_t i, const VehicleTrip& y, size_t j) { return RouteMoves::crossExchange(x, i, 2, y, j, 1); },
+            [](VehicleTrip& x, size_t i, VehicleTrip& y, size_t j) { RouteMoves::applyCrossExchange(x, i, 2, y, j, 1); });
+}
+
+TEST(RouteMoves, renumberedTripsPriceWithTheirNewIds)
+{
+    std::stringstream json(eightClientInstanceJson);
+    DataModel model(json);
+    SolutionModel solution = SolutionFinder(model).importSolution({{2, 3, 4}, {5, 6, 7, 8}, {1}});
+    for (auto& trip : solution.chromosomes())
+    {
+        trip.reEvaluateInOrder();
+    }
+
+    /* Client 1 goes, so every other client moves down one ID */
+    InstanceDelta delta;
+    delta.removed = { 1 };
+    std::vector<int> newIds;
+    std::unique_ptr<DataModel> edited = delta.apply(model, DataModelOptions(), newIds);
+    VehicleTrip a = solution.chromosomesConst()[0];
+    VehicleTrip b = solution.chromosomesConst()[1];
+    a.renumber(*edited, newIds);
+    b.renumber(*edited, newIds);
+    ASSERT_TRUE(a.hasSegments());
+    VehicleTrip fresh(*edited);
+    fresh.clientSequence() = a.clientSeqConst();
+    fresh.reEvaluateInOrder();
+    EXPECT_EQ(a.hash(), fresh.hash());
+    EXPECT_EQ(a.segment(0, 3).hash, fresh.segment(0, 3).hash);
+    EXPECT_EQ(a.segment(1, 3).first, fresh.clientSeqConst()[1]);
+
+    checkAgainstApplying(a, b, 1, 1, RouteMoves::swap,
+            [](VehicleTrip& x, size_t i, VehicleTrip& y, size_t j) { RouteMoves::applyCrossExchange(x, i, 1, y, j, 1); });
+    checkAgainstApplying(a, b, 0, 0, RouteMoves::twoOptStar, RouteMoves::applyTwoOptStar);
+}
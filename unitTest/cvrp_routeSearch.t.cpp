@@ -0,0 +1,82 @@
+#include "gtest/gtest.h"
+#include "../src/cvrp_routeSearch.h"
+#include "../src/cvrp_dataModel.h"
+#include "../src/cvrp_vehicleTrip.h"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+using namespace cvrp;
+
+namespace
+{
+/* Eight clients on a ring around the depot, in a scrambled order */
+const char *instanceJson = "{\"vehicleCapacity\": 100,\"depot\": {\"x\": 50, \"y\": 50},\"nodes\": ["
+    "{\"x\": 90, \"y\": 50, \"demand\": 1},{\"x\": 50, \"y\": 10, \"demand\": 1},{\"x\": 78, \"y\": 78, \"demand\": 1},"
+    "{\"x\": 22, \"y\": 22, \"demand\": 1},{\"x\": 10, \"y\": 50, \"demand\": 1},{\"x\": 78, \"y\": 22, \"demand\": 1},"
+    "{\"x\": 50, \"y\": 90, \"demand\": 1},{\"x\": 22, \"y\": 78, \"demand\": 1}]}";
+
+Cost routeCost(const ClientSequence& route, const ModelView& model)
+{
+    Cost cost = 0;
+    int previous = 0;
+    for (const int client : route)
+    {
+        cost += model.distance(previous, client);
+        previous = client;
+    }
+    return cost + model.distance(previous, 0);
+}
+}
+
+TEST(RouteSearch, parsesOptimiserNames)
+{
+    EXPECT_EQ(RouteSearch::parse("greedy"), RouteOptimiser::Greedy);
+    EXPECT_EQ(RouteSearch::parse("2opt"), RouteOptimiser::TwoOpt);
+    EXPECT_EQ(RouteSearch::parse("local"), RouteOptimiser::LocalSearch);
+    EXPECT_STREQ(RouteSearch::name(RouteOptimiser::LocalSearch), "local");
+    EXPECT_THROW(RouteSearch::parse("3opt"), std::invalid_argument);
+}
+
+TEST(RouteSearch, twoOptRemovesCrossings)
+{
+    std::stringstream json(instanceJson);
+    DataModel model(json);
+    /* Around the ring is 1 3 7 8 5 4 2 6; swapping 3 and 8 makes the route cross itself */
+    ClientSequence route = {1, 8, 7, 3, 5, 4, 2, 6};
+    const Cost cost = RouteSearch::twoOpt(route, model.view(), routeCost(route, model.view()));
+    EXPECT_NEAR(cost, routeCost(route, model.view()), 1e-6);
+    EXPECT_TRUE(route == ClientSequence({1, 3, 7, 8, 5, 4, 2, 6}) || route == ClientSequence({6, 2, 4, 5, 8, 7, 3, 1}));
+}
+
+TEST(RouteSearch, orOptKeepsTheCostExact)
+{
+    std::stringstream json(instanceJson);
+    DataModel model(json);
+    ClientSequence route = {1, 4, 3, 7, 5, 8, 2, 6};
+    const Cost before = routeCost(route, model.view());
+    const Cost cost = RouteSearch::orOpt(route, model.view(), before);
+    EXPECT_LT(cost, before);
+    EXPECT_NEAR(cost, routeCost(route, model.view()), 1e-6);
+    ClientSequence sorted = route;
+    std::sort(sorted.begin(), sorted.end());
+    EXPECT_EQ(sorted, ClientSequence({1, 2, 3, 4, 5, 6, 7, 8}));
+}
+
+TEST(RouteSearch, localSearchNeverWorsensTheGreedyOrder)
+{
+    std::stringstream json(instanceJson);
+    DataModel model(json);
+    VehicleTrip greedy(model);
+    VehicleTrip local(model);
+    for (int client = 1; client <= 8; client++)
+    {
+        greedy.addClientToTrip(client);
+        local.addClientToTrip(client);
+    }
+    greedy.optimiseCost();
+    local.optimiseCost(RouteOptimiser::LocalSearch);
+    EXPECT_LE(local.cost(), greedy.cost() + 1e-6);
+    EXPECT_NEAR(local.cost(), routeCost(local.clientSeqConst(), model.view()), 1e-6);
+}
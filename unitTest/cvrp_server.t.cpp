@@ -0,0 +1,57 @@
+#include "gtest/gtest.h"
+#include "../src/cvrp_server.h"
+#include "cvrp_testFixtures.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <unistd.h>
+
+using namespace cvrp;
+
+namespace
+{
+ServerOptions smallServer()
+{
+    ServerOptions options;
+    options.evolution = smallBudget();
+    options.cacheSize = 1;
+    return options;
+}
+}
+
+TEST(Server, answersEachRequestWithItsId)
+{
+    char path[] = "/tmp/cvrpServerXXXXXX.json";
+    const int fd = mkstemps(path, 5);
+    ASSERT_GE(fd, 0);
+    close(fd);
+    std::ofstream(path) << smallInstanceJson;
+
+    Server server(smallServer());
+    const std::string request = std::string("{\"id\": \"a\", \"instance\": \"") + path + "\", \"seed\": 3, \"timeLimit\": 5}";
+    const std::string first = server.handle(request);
+    EXPECT_EQ(first.find("{\"id\":\"a\",\"seconds\":"), 0u);
+    EXPECT_NE(first.find("\"cached\":false,\"cost\":"), std::string::npos);
+    EXPECT_EQ(first.back(), '\n');
+    EXPECT_NE(server.handle(request).find("\"cached\":true"), std::string::npos);
+
+    /* Inline instances share the single cache slot, evicting the file */
+    const std::string inlined = server.handle(std::string("{\"id\": 2, \"instance\": ") + smallInstanceJson + "}");
+    EXPECT_EQ(inlined.find("{\"id\":2,"), 0u);
+    EXPECT_NE(inlined.find("\"routes\":[{\"clients\":["), std::string::npos);
+    EXPECT_EQ(server.cachedInstances(), 1u);
+    EXPECT_NE(server.handle(request).find("\"cached\":false"), std::string::npos);
+
+    unlink(path);
+}
+
+TEST(Server, reportsBadRequests)
+{
+    Server server(smallServer());
+    EXPECT_EQ(server.handle("{\"id\": [1, 2], \"instance\": \"/nonexistent.json\"}").find("{\"id\":[1, 2],\"error\":\"Cannot open"), 0u);
+    EXPECT_EQ(server.handle("{\"id\": 4}"), "{\"id\":4,\"error\":\"request has no instance\"}\n");
+    EXPECT_EQ(server.handle("{\"id\": 5, \"timeLimit\": -1, \"instance\": \"x\"}"),
+            "{\"id\":5,\"error\":\"request:1: timeLimit must be a number of seconds\"}\n");
+    EXPECT_EQ(server.handle("not json").find("{\"id\":null,\"error\":"), 0u);
+}
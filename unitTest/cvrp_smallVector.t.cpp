@@ -0,0 +1,67 @@
+#include "gtest/gtest.h"
+#include "../src/cvrp_smallVector.h"
+
+#include <utility>
+#include <vector>
+
+using namespace cvrp;
+
+typedef SmallVector<int, 4> Small;
+
+TEST(SmallVector, staysInlineUpToItsCapacity)
+{
+    Small values;
+    for (int i = 0; i < 4; i++)
+    {
+        values.push_back(i);
+    }
+    EXPECT_TRUE(values.isInline());
+    values.push_back(4);
+    EXPECT_FALSE(values.isInline());
+    EXPECT_EQ(values, Small({0, 1, 2, 3, 4}));
+
+    /* A copy only goes to the heap when its elements do not fit inline */
+    values.erase(values.begin() + 1, values.begin() + 3);
+    const Small copy = values;
+    EXPECT_TRUE(copy.isInline());
+    EXPECT_EQ(copy, Small({0, 3, 4}));
+    values.shrink_to_fit();
+    EXPECT_TRUE(values.isInline());
+    EXPECT_EQ(values, copy);
+}
+
+TEST(SmallVector, movesStealHeapBuffers)
+{
+    Small large = {1, 2, 3, 4, 5, 6};
+    const int *buffer = large.data();
+    Small moved = std::move(large);
+    EXPECT_EQ(moved.data(), buffer);
+    EXPECT_TRUE(large.empty());
+    EXPECT_TRUE(large.isInline());
+
+    Small small = {7, 8};
+    moved = std::move(small);
+    EXPECT_EQ(moved, Small({7, 8}));
+    EXPECT_TRUE(moved.isInline());
+}
+
+TEST(SmallVector, insertsAndErasesLikeVector)
+{
+    std::vector<int> expected = {1, 2, 3};
+    Small values(expected.begin(), expected.end());
+    const std::vector<int> more = {7, 8, 9};
+
+    values.insert(values.begin() + 1, more.begin(), more.end());
+    expected.insert(expected.begin() + 1, more.begin(), more.end());
+    values.insert(values.end(), 5);
+    expected.insert(expected.end(), 5);
+    values.erase(values.begin());
+    expected.erase(expected.begin());
+    values.resize(9);
+    expected.resize(9);
+    EXPECT_EQ(std::vector<int>(values.begin(), values.end()), expected);
+
+    EXPECT_LT(Small({1, 2}), Small({1, 3}));
+    EXPECT_LT(Small({1, 2}), Small({1, 2, 0}));
+    EXPECT_FALSE(Small({1, 2}) < Small({1, 2}));
+}
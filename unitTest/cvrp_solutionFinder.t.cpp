@@ -3,32 +3,44 @@
 #include "../src/cvrp_solutionFinder.h"
 #include "../src/cvrp_dataModel.h"
 #include "../src/cvrp_solutionModel.h"
+#include "../src/cvrp_util.h"
+#include "cvrp_testFixtures.h"
 
 using ::testing::ContainerEq;
 using namespace cvrp;
 
-TEST(SolutionFinder, basicSetup) {
-    int e[] = {1, 2, 3, 4};
-    std::vector<int> expectedDna(&e[0], &e[0]+4);
+namespace
+{
+/* Costs of the trips {2, 1} and {4, 3} below; a ROUNDED=y build rounds every edge */
+#ifdef CVRP_ROUNDED_DISTANCES
+const Cost firstTripCost = 55;
+const Cost secondTripCost = 53;
+#else
+const Cost firstTripCost = 54.5762;
+const Cost secondTripCost = 52.7178;
+#endif
+}
 
+TEST(SolutionFinder, basicSetup) {
     std::stringstream jsonData;
     jsonData << "{\"vehicleCapacity\": 220,\"depot\": {\"x\": 40, \"y\": 40},\"nodes\": [{\"x\": 22, \"y\": 22, \"demand\": 18},{\"x\": 36, \"y\": 26, \"demand\": 26},{\"x\": 21, \"y\": 45, \"demand\": 11},{\"x\": 45, \"y\": 35, \"demand\": 30}]}";
     DataModel model(jsonData);
     
-    SolutionFinder solution(&model);
+    SolutionFinder solutionFinder(model);
 
-    EXPECT_EQ(solution.dnaSequence().size(), 4);
-    ASSERT_THAT(solution.dnaSequence(), ContainerEq(expectedDna));
+    SolutionModel solution = solutionFinder.getNaiveSolution(model.getClients());
+    EXPECT_EQ(solution.chromosomes().size(), 1);
+    EXPECT_EQ(solution.chromosomes()[0].clientSeqConst().size(), 4);
+    EXPECT_TRUE(solutionFinder.validateSolution(solution));
 }
 
 TEST(SolutionFinder, testBasicSolution) {
     std::stringstream jsonData;
     jsonData << "{\"vehicleCapacity\": 45,\"depot\": {\"x\": 40, \"y\": 40},\"nodes\": [{\"x\": 22, \"y\": 22, \"demand\": 18},{\"x\": 36, \"y\": 26, \"demand\": 26},{\"x\": 21, \"y\": 45, \"demand\": 11},{\"x\": 45, \"y\": 35, \"demand\": 30}]}";
     DataModel model(jsonData);
-    SolutionFinder solutionFinder(&model);
+    SolutionFinder solutionFinder(model);
 
-    SolutionModel solution;
-    solutionFinder.getSolution(solution);
+    SolutionModel solution = solutionFinder.getNaiveSolution({1, 2, 3, 4});
 
     EXPECT_EQ(solution.chromosomes().size(), 2);
     EXPECT_EQ(solution.chromosomes()[0].clientSeqConst().size(), 2);
@@ -40,24 +52,24 @@ TEST(SolutionFinder, testBasicSolution) {
     EXPECT_EQ(solution.chromosomes()[1].clientSeqConst()[0], 4);
     EXPECT_EQ(solution.chromosomes()[1].clientSeqConst()[1], 3);
 
-    EXPECT_NEAR(solution.chromosomes()[0].cost(), 54.5762, 0.001);
-    EXPECT_NEAR(solution.chromosomes()[1].cost(), 52.7178, 0.001);
+    EXPECT_NEAR(solution.chromosomes()[0].cost(), firstTripCost, 0.001);
+    EXPECT_NEAR(solution.chromosomes()[1].cost(), secondTripCost, 0.001);
 
     EXPECT_EQ(solution.chromosomes()[0].demandCovered(), 44);
     EXPECT_EQ(solution.chromosomes()[1].demandCovered(), 41);
 
     EXPECT_TRUE(solutionFinder.validateSolution(solution));
-    EXPECT_NEAR(solutionFinder.solutionCost(solution), 54.5762+52.7178, 0.001);
+    EXPECT_NEAR(solution.getCost(), firstTripCost + secondTripCost, 0.001);
 }
 
 TEST(SolutionFinder, testSolutionDemandValidation) {
     std::stringstream jsonData;
     jsonData << "{\"vehicleCapacity\": 45,\"depot\": {\"x\": 40, \"y\": 40},\"nodes\": [{\"x\": 22, \"y\": 22, \"demand\": 18},{\"x\": 36, \"y\": 26, \"demand\": 26},{\"x\": 21, \"y\": 45, \"demand\": 11},{\"x\": 45, \"y\": 35, \"demand\": 30}]}";
     DataModel model(jsonData);
-    SolutionFinder solutionFinder(&model);
+    SolutionFinder solutionFinder(model);
 
     SolutionModel solution;
-    solution.chromosomes().push_back(VehicleTrip(&model));
+    solution.chromosomes().push_back(VehicleTrip(model));
     solution.chromosomes()[0].addClientToTrip(2);
     solution.chromosomes()[0].addClientToTrip(4);
 
@@ -68,11 +80,11 @@ TEST(SolutionFinder, testSolutionRouteValidation) {
     std::stringstream jsonData;
     jsonData << "{\"vehicleCapacity\": 45,\"depot\": {\"x\": 40, \"y\": 40},\"nodes\": [{\"x\": 22, \"y\": 22, \"demand\": 18},{\"x\": 36, \"y\": 26, \"demand\": 26},{\"x\": 21, \"y\": 45, \"demand\": 11},{\"x\": 45, \"y\": 35, \"demand\": 30}]}";
     DataModel model(jsonData);
-    SolutionFinder solutionFinder(&model);
+    SolutionFinder solutionFinder(model);
 
     SolutionModel solution;
-    solution.chromosomes().push_back(VehicleTrip(&model));
-    solution.chromosomes().push_back(VehicleTrip(&model));
+    solution.chromosomes().push_back(VehicleTrip(model));
+    solution.chromosomes().push_back(VehicleTrip(model));
     solution.chromosomes()[0].addClientToTrip(1);
     solution.chromosomes()[0].addClientToTrip(2);
     solution.chromosomes()[1].addClientToTrip(3);
@@ -80,3 +92,71 @@ TEST(SolutionFinder, testSolutionRouteValidation) {
     EXPECT_FALSE(solutionFinder.validateSolution(solution));
 }
 
+TEST(SolutionFinder, testImportSolution) {
+    std::stringstream jsonData;
+    jsonData << "{\"vehicleCapacity\": 45,\"depot\": {\"x\": 40, \"y\": 40},\"nodes\": [{\"x\": 22, \"y\": 22, \"demand\": 18},{\"x\": 36, \"y\": 26, \"demand\": 26},{\"x\": 21, \"y\": 45, \"demand\": 11},{\"x\": 45, \"y\": 35, \"demand\": 30}]}";
+    DataModel model(jsonData);
+    SolutionFinder solutionFinder(model);
+
+    SolutionModel solution = solutionFinder.importSolution({{1, 2}, {3, 4}});
+    EXPECT_EQ(solution.chromosomes().size(), 2);
+    EXPECT_EQ(solution.chromosomes()[0].demandCovered(), 44);
+    EXPECT_NEAR(solution.getCost(), firstTripCost + secondTripCost, 0.001);
+    EXPECT_TRUE(solutionFinder.validateSolution(solution));
+
+    EXPECT_FALSE(solutionFinder.validateSolution(solutionFinder.importSolution({{1, 2}, {3}})));
+    EXPECT_THROW(solutionFinder.importSolution({{1, 2}, {3, 5}}), std::invalid_argument);
+    EXPECT_THROW(solutionFinder.importSolution({{1, 2}, {3, 2}}), std::invalid_argument);
+    EXPECT_THROW(solutionFinder.importSolution({{0, 1}}), std::invalid_argument);
+}
+
+TEST(SolutionFinder, crossoverOnlyTouchesItsTwoSubjects)
+{
+    std::stringstream json(eightClientInstanceJson);
+    DataModel model(json);
+    SolutionFinder solutionFinder(model);
+    const SolutionModel solution = solutionFinder.importSolution({{1, 2}, {3, 4}, {5, 6}, {7, 8}});
+
+    Util::seed_prngs(7);
+    int crossovers = 0;
+    for (int round = 0; round < 200; round++)
+    {
+        const SolutionModel crossed = solutionFinder.make_crossover(solution);
+        ASSERT_EQ(crossed.chromosomesConst().size(), solution.chromosomesConst().size());
+        int changed = 0;
+        Cost cost = 0;
+        uint64_t hash = 0;
+        bool feasible = true;
+        for (size_t t = 0; t < crossed.chromosomesConst().size(); t++)
+        {
+            const VehicleTrip& trip = crossed.chromosomesConst()[t];
+            cost += trip.cost();
+            hash ^= trip.hash();
+            feasible = feasible && trip.isValidTrip();
+            const VehicleTrip& original = solution.chromosomesConst()[t];
+            if (trip.clientSeqConst() != original.clientSeqConst())
+            {
+                changed++;
+            }
+            else
+            {
+                EXPECT_EQ(trip.cost(), original.cost());
+                EXPECT_EQ(trip.demandCovered(), original.demandCovered());
+            }
+            /* Cached cost, demand and hash all match a full recompute of the trip as it stands */
+            VehicleTrip recomputed = trip;
+            recomputed.reEvaluateInOrder();
+            EXPECT_NEAR(trip.cost(), recomputed.cost(), 1e-9);
+            EXPECT_EQ(trip.demandCovered(), recomputed.demandCovered());
+            EXPECT_EQ(trip.hash(), recomputed.hash());
+        }
+        /* The solution's cached totals were updated from the two subjects alone */
+        EXPECT_NEAR(crossed.getCost(), cost, 1e-9);
+        EXPECT_EQ(crossed.hash(), hash);
+        EXPECT_EQ(crossed.isFeasible(), feasible);
+        EXPECT_TRUE(changed == 0 || changed == 2) << changed;
+        crossovers += changed == 2;
+        EXPECT_TRUE(solutionFinder.validateSolution(crossed));
+    }
+    EXPECT_GT(crossovers, 0);
+}
@@ -0,0 +1,48 @@
+#include "gtest/gtest.h"
+#include "../src/cvrp_solutionModel.h"
+#include "../src/cvrp_dataModel.h"
+#include "../src/cvrp_solutionFinder.h"
+#include "cvrp_testFixtures.h"
+
+#include <algorithm>
+#include <set>
+#include <sstream>
+
+using namespace cvrp;
+
+TEST(SolutionModel, hashIgnoresTheOrderOfTrips)
+{
+    std::stringstream json(eightClientInstanceJson);
+    DataModel model(json);
+    SolutionFinder finder(model);
+    SolutionModel solution = finder.importSolution({{1, 2, 3}, {4}, {5, 6}, {7, 8}});
+    const uint64_t hash = solution.hash();
+    std::reverse(solution.chromosomes().begin(), solution.chromosomes().end());
+    EXPECT_EQ(solution.hash(), hash);
+    EXPECT_NE(finder.importSolution({{1, 2}, {3, 4}, {5, 6}, {7, 8}}).hash(), hash);
+    EXPECT_NE(finder.importSolution({{1, 2, 3, 4}, {5, 6}, {7, 8}}).hash(), hash);
+}
+
+TEST(SolutionModel, populationKeepsOneOfEachSetOfRoutes)
+{
+    /* Four clients at the compass points, so that pairing them either way round costs the same */
+    std::stringstream json("{\"vehicleCapacity\": 20,\"depot\": {\"x\": 50, \"y\": 50},\"nodes\": ["
+            "{\"x\": 40, \"y\": 50, \"demand\": 10},{\"x\": 60, \"y\": 50, \"demand\": 10},"
+            "{\"x\": 50, \"y\": 40, \"demand\": 10},{\"x\": 50, \"y\": 60, \"demand\": 10}]}");
+    DataModel model(json);
+    SolutionFinder finder(model);
+    std::set<SolutionModel, PopulationOrder> population;
+
+    const SolutionModel solution = finder.importSolution({{1, 3}, {2, 4}});
+    EXPECT_TRUE(population.insert(solution).second);
+    /* The same routes with the trips the other way round */
+    SolutionModel reordered = solution;
+    std::reverse(reordered.chromosomes().begin(), reordered.chromosomes().end());
+    EXPECT_FALSE(population.insert(reordered).second);
+
+    /* As cheap, but other edges */
+    const SolutionModel other = finder.importSolution({{1, 4}, {2, 3}});
+    EXPECT_NEAR(other.getCost(), solution.getCost(), 1e-9);
+    EXPECT_TRUE(population.insert(other).second);
+    EXPECT_EQ(population.size(), 2u);
+}
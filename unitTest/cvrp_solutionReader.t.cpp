@@ -0,0 +1,64 @@
+#include "gtest/gtest.h"
+#include "../src/cvrp_solutionReader.h"
+#include "../src/cvrp_solutionFinder.h"
+#include "../src/cvrp_dataModel.h"
+
+#include <sstream>
+#include <stdexcept>
+
+using namespace cvrp;
+
+TEST(SolutionReader, readsPrintedSolutions)
+{
+    const std::vector<SolutionRoutes> solutions = SolutionReader::parse(
+            "*** THE BEST ***\n\n"
+            "x->4->45->29->x ------- 207\n"
+            "x->51->16->x ------- 197\n"
+            "Total Cost: 790.345\n"
+            "####\n"
+            "  x->3->x\n"
+            "x->x\n", "best.txt");
+    ASSERT_EQ(solutions.size(), 2u);
+    EXPECT_EQ(solutions[0], SolutionRoutes({{4, 45, 29}, {51, 16}}));
+    EXPECT_EQ(solutions[1], SolutionRoutes({{3}, {}}));
+}
+
+TEST(SolutionReader, rejectsMalformedRoutes)
+{
+    EXPECT_THROW(SolutionReader::parse("x->4->45\n", "a"), std::invalid_argument);
+    EXPECT_THROW(SolutionReader::parse("x->4-45->x\n", "a"), std::invalid_argument);
+    EXPECT_THROW(SolutionReader::parse("x->4->y->x\n", "a"), std::invalid_argument);
+    try
+    {
+        SolutionReader::parse("\nx->4->x ------- 7 trucks\n", "plan.txt");
+        FAIL();
+    }
+    catch (const std::invalid_argument& error)
+    {
+        EXPECT_STREQ(error.what(), "plan.txt:2: unexpected text after the route");
+    }
+}
+
+TEST(SolutionReader, warmStartRepairsAChangedInstance)
+{
+    std::stringstream json("{\"vehicleCapacity\": 40,\"depot\": {\"x\": 0, \"y\": 0},\"nodes\": ["
+            "{\"x\": 1, \"y\": 0, \"demand\": 20},{\"x\": 2, \"y\": 0, \"demand\": 20},"
+            "{\"x\": 3, \"y\": 0, \"demand\": 20},{\"x\": 4, \"y\": 0, \"demand\": 10}]}");
+    DataModel model(json);
+    SolutionFinder finder(model);
+    /* Client 9 is gone, 2 is repeated, 4 is new and the first route is now over capacity */
+    const SolutionModel solution = finder.warmStart({{1, 2, 3}, {9, 2}});
+    EXPECT_TRUE(finder.validateSolution(solution));
+    EXPECT_TRUE(solution.isFeasible());
+    /* 4 joins the trip 3 was split into, which has room for it */
+    ASSERT_EQ(solution.chromosomesConst().size(), 2u);
+    EXPECT_EQ(solution.chromosomesConst()[0].clientSeqConst(), ClientSequence({1, 2}));
+    EXPECT_EQ(solution.chromosomesConst()[1].clientSeqConst(), ClientSequence({3, 4}));
+
+    EvolutionOptions options;
+    options.initialPopulation = 20;
+    options.maxGenerations = 2;
+    options.maxMutationsPerGeneration = 100;
+    options.progress = false;
+    EXPECT_TRUE(finder.validateSolution(finder.solutionWithEvolution(options, { solution })));
+}
@@ -0,0 +1,53 @@
+#include "gtest/gtest.h"
+#include "../src/cvrp_solutionWriter.h"
+#include "../src/cvrp_solutionFinder.h"
+#include "../src/cvrp_dataModel.h"
+
+#include <cstring>
+
+using namespace cvrp;
+
+namespace
+{
+const char *instanceJson = "{\"vehicleCapacity\": 220,\"depot\": {\"x\": 40, \"y\": 40},\"nodes\": [{\"x\": 22, \"y\": 22, \"demand\": 18},{\"x\": 36, \"y\": 26, \"demand\": 26},{\"x\": 21, \"y\": 45, \"demand\": 11},{\"x\": 45, \"y\": 35, \"demand\": 30}]}";
+}
+
+TEST(SolutionWriter, allFormats)
+{
+    std::stringstream jsonData(instanceJson);
+    DataModel model(jsonData);
+    SolutionFinder finder(model);
+    const SolutionModel solution = finder.importSolution({{2, 3}, {4}, {1}});
+
+    std::string text;
+    SolutionWriter::render(solution, SolutionFormat::Text, text);
+    EXPECT_EQ(text.substr(0, 45), "x->2->3->x ------- 37\nx->4->x ------- 30\nx->1");
+    EXPECT_NE(text.find("\nTotal Cost: "), std::string::npos);
+
+    std::string json;
+    SolutionWriter::render(solution, SolutionFormat::Json, json);
+    EXPECT_EQ(json.find("{\"cost\":"), 0u);
+    EXPECT_NE(json.find("\"routes\":[{\"clients\":[2,3],\"load\":37,\"cost\":"), std::string::npos);
+    EXPECT_NE(json.find("{\"clients\":[1],\"load\":18,\"cost\":"), std::string::npos);
+    EXPECT_EQ(json.back(), '\n');
+
+    std::string binary;
+    SolutionWriter::render(solution, SolutionFormat::Binary, binary);
+    BinarySolutionHeader header;
+    ASSERT_GE(binary.size(), sizeof(header));
+    memcpy(&header, binary.data(), sizeof(header));
+    EXPECT_STREQ(header.magic, "CVRPSOL");
+    EXPECT_EQ(header.routes, 3u);
+    EXPECT_DOUBLE_EQ(header.cost, solution.getCost());
+    BinaryRouteHeader route;
+    memcpy(&route, binary.data() + sizeof(header), sizeof(route));
+    EXPECT_EQ(route.clients, 2u);
+    EXPECT_EQ(route.load, 37);
+    int clients[2];
+    memcpy(clients, binary.data() + sizeof(header) + sizeof(route), sizeof(clients));
+    EXPECT_EQ(clients[0], 2);
+    EXPECT_EQ(clients[1], 3);
+    EXPECT_EQ(binary.size(), sizeof(header) + 3 * sizeof(route) + 4 * sizeof(int));
+
+    EXPECT_THROW(SolutionWriter::parseFormat("xml"), std::invalid_argument);
+}
@@ -0,0 +1,63 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <algorithm>
+#include "../src/cvrp_spatialGrid.h"
+
+using ::testing::ElementsAre;
+using ::testing::UnorderedElementsAre;
+using namespace cvrp;
+
+TEST(SpatialGrid, nearestMatchesBruteForce)
+{
+    std::mt19937 prng(7);
+    std::uniform_int_distribution<int> coord(0, 500);
+    AlignedVector<int> xs(1001), ys(1001);
+    for (size_t i = 0; i < xs.size(); i++)
+    {
+        xs[i] = coord(prng);
+        ys[i] = coord(prng);
+    }
+    SpatialGrid grid;
+    grid.build(Span<const int>(xs.data(), xs.size()), Span<const int>(ys.data(), ys.size()));
+
+    std::vector<int> nearest;
+    for (int i = 0; i < 1001; i += 37)
+    {
+        std::vector<std::pair<long, int>> all;
+        for (int j = 1; j < 1001; j++)
+        {
+            if (j != i)
+            {
+                long dx = xs[j] - xs[i], dy = ys[j] - ys[i];
+                all.emplace_back(dx*dx + dy*dy, j);
+            }
+        }
+        std::sort(all.begin(), all.end());
+
+        grid.nearest(xs[i], ys[i], 10, nearest, i);
+        ASSERT_EQ(nearest.size(), 10);
+        for (int k = 0; k < 10; k++)
+        {
+            EXPECT_EQ(nearest[k], all[k].second);
+        }
+    }
+}
+
+TEST(SpatialGrid, radiusAndOutsideQueries)
+{
+    AlignedVector<int> xs = {40, 22, 36, 21, 45};
+    AlignedVector<int> ys = {40, 22, 26, 45, 35};
+    SpatialGrid grid;
+    grid.build(Span<const int>(xs.data(), xs.size()), Span<const int>(ys.data(), ys.size()));
+
+    std::vector<int> found;
+    grid.withinRadius(40, 40, 15.0, found);
+    EXPECT_THAT(found, UnorderedElementsAre(2, 4));
+    grid.withinRadius(40, 40, 1.0, found);
+    EXPECT_TRUE(found.empty());
+
+    grid.nearest(1000, 1000, 2, found);
+    EXPECT_THAT(found, ElementsAre(4, 3));
+    grid.nearest(0, 0, 10, found);
+    EXPECT_THAT(found, ElementsAre(1, 2, 3, 4));
+}
@@ -0,0 +1,29 @@
+#ifndef CVRP_TEST_FIXTURES
+#define CVRP_TEST_FIXTURES
+
+#include "../src/cvrp_solutionFinder.h"
+
+namespace cvrp
+{
+/* Six clients that need two or three trips, solved in milliseconds */
+inline const char *smallInstanceJson = "{\"vehicleCapacity\": 60,\"depot\": {\"x\": 40, \"y\": 40},\"nodes\": [{\"x\": 22, \"y\": 22, \"demand\": 18},{\"x\": 36, \"y\": 26, \"demand\": 26},{\"x\": 21, \"y\": 45, \"demand\": 11},{\"x\": 45, \"y\": 35, \"demand\": 30},{\"x\": 55, \"y\": 20, \"demand\": 21},{\"x\": 33, \"y\": 34, \"demand\": 19}]}";
+
+/* Eight clients in two groups of four, each group filling one vehicle of capacity 30 */
+inline const char *eightClientInstanceJson = "{\"vehicleCapacity\": 30,\"depot\": {\"x\": 50, \"y\": 50},\"nodes\": ["
+    "{\"x\": 10, \"y\": 13, \"demand\": 7},{\"x\": 17, \"y\": 31, \"demand\": 9},{\"x\": 33, \"y\": 8, \"demand\": 5},"
+    "{\"x\": 41, \"y\": 27, \"demand\": 8},{\"x\": 88, \"y\": 71, \"demand\": 6},{\"x\": 72, \"y\": 94, \"demand\": 9},"
+    "{\"x\": 95, \"y\": 55, \"demand\": 4},{\"x\": 64, \"y\": 83, \"demand\": 7}]}";
+
+/* A quiet evolution budget small enough for unit tests */
+inline EvolutionOptions smallBudget()
+{
+    EvolutionOptions options;
+    options.initialPopulation = 50;
+    options.maxGenerations = 2;
+    options.maxMutationsPerGeneration = 1000;
+    options.progress = false;
+    return options;
+}
+
+}//cvrp namespace
+#endif
@@ -12,25 +12,15 @@ TEST(Util, euclideanDistances)
     EXPECT_NEAR(Util::distance(2, 2, 2, 2), 0.0, 0.0001);
 }
 
-TEST(Util, swapArrayElements)
-{
-    std::vector<int> arr = {3, 5, 2, 1, 6};
-
-    Util::swapElements(arr, 0, 3);
-
-    EXPECT_EQ(arr[0], 1);
-    EXPECT_EQ(arr[3], 3);
-}
-
 TEST(Util, testSplitAndCascade)
 {
-    std::vector<int> arr1 = {3, 5, 2, 1, 6};
-    std::vector<int> arr2 = {4, 7, 9, 8};
+    ClientSequence arr1 = {3, 5, 2, 1, 6};
+    ClientSequence arr2 = {4, 7, 9, 8};
 
     Util::splitAndCascade(arr1, arr2, 2);
 
-    std::vector<int> exparr1 = {3, 5, 9, 8};
-    std::vector<int> exparr2 = {4, 7, 2, 1, 6};
+    ClientSequence exparr1 = {3, 5, 9, 8};
+    ClientSequence exparr2 = {4, 7, 2, 1, 6};
 
     ASSERT_THAT(arr1, ContainerEq(exparr1));
     ASSERT_THAT(arr2, ContainerEq(exparr2));
@@ -38,28 +28,35 @@ TEST(Util, testSplitAndCascade)
 
 TEST(Util, testSplitAndFlipCascade)
 {
-    std::vector<int> arr1 = {3, 5, 2, 1, 6};
-    std::vector<int> arr2 = {4, 7, 9, 8};
+    ClientSequence arr1 = {3, 5, 2, 1, 6};
+    ClientSequence arr2 = {4, 7, 9, 8};
 
     Util::splitAndFlipCascade(arr1, arr2, 2);
 
-    std::vector<int> exparr1 = {3, 5, 4, 7};
-    std::vector<int> exparr2 = {9, 8, 2, 1, 6};
+    ClientSequence exparr1 = {3, 5, 4, 7};
+    ClientSequence exparr2 = {9, 8, 2, 1, 6};
 
     ASSERT_THAT(arr1, ContainerEq(exparr1));
     ASSERT_THAT(arr2, ContainerEq(exparr2));
 }
 
-TEST(Util, testSpliceAndCascade)
+TEST(Util, batchDistanceKernels)
 {
-    std::vector<int> arr1 = {3, 5, 2, 1, 6};
-    std::vector<int> arr2 = {4, 7, 9, 8};
-
-    Util::spliceAndCascade(arr1, arr2, 1, 3);
-
-    std::vector<int> exparr1 = {3, 1, 6, 7, 9};
-    std::vector<int> exparr2 = {4, 8, 5, 2};
-
-    ASSERT_THAT(arr1, ContainerEq(exparr1));
-    ASSERT_THAT(arr2, ContainerEq(exparr2));
+    std::vector<int> xs = {22, 36, 21, 45, 55, 33, 50, 55, 26, 40, 55};
+    std::vector<int> ys = {22, 26, 45, 35, 20, 34, 50, 45, 59, 66, 65};
+    std::vector<double> distances(xs.size()), squared(xs.size());
+
+    Util::distancesFrom(40, 40, xs.data(), ys.data(), xs.size(), distances.data());
+    Util::squaredDistancesFrom(40, 40, xs.data(), ys.data(), xs.size(), squared.data());
+    for (size_t i = 0; i < xs.size(); i++)
+    {
+        EXPECT_EQ(distances[i], Util::distance(40, 40, xs[i], ys[i]));
+        EXPECT_EQ(squared[i], (xs[i] - 40) * (xs[i] - 40) + (ys[i] - 40) * (ys[i] - 40));
+    }
+
+    EXPECT_EQ(Util::nearestOf(40, 40, xs.data(), ys.data(), xs.size()), 3);
+    EXPECT_EQ(Util::nearestOf(55, 45, xs.data(), ys.data(), xs.size()), 7);
+    /* First of equally near points */
+    EXPECT_EQ(Util::nearestOf(60, 55, xs.data(), ys.data(), xs.size()), 6);
+    EXPECT_EQ(Util::nearestOf(40, 40, xs.data(), ys.data(), 0), 0);
 }
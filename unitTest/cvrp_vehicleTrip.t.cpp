@@ -2,6 +2,7 @@
 #include "gmock/gmock.h"
 #include "../src/cvrp_vehicleTrip.h"
 #include "../src/cvrp_dataModel.h"
+#include "cvrp_testFixtures.h"
 
 using ::testing::ContainerEq;
 using namespace cvrp;
@@ -11,7 +12,7 @@ TEST(VehicleTrip, testCanAccommodate)
     std::stringstream jsonData;
     jsonData << "{\"vehicleCapacity\": 20,\"depot\": {\"x\": 40, \"y\": 40},\"nodes\": [{\"x\": 22, \"y\": 22, \"demand\": 18},{\"x\": 36, \"y\": 26, \"demand\": 26},{\"x\": 21, \"y\": 45, \"demand\": 11},{\"x\": 45, \"y\": 35, \"demand\": 30}]}";
     DataModel model(jsonData);
-    VehicleTrip trip(&model);
+    VehicleTrip trip(model);
 
     EXPECT_TRUE(trip.canAccommodate(1));
     EXPECT_FALSE(trip.canAccommodate(2));
@@ -25,9 +26,9 @@ TEST(VehicleTrip, testOptimiseTrip)
     std::stringstream jsonData;
     jsonData << "{\"vehicleCapacity\": 200,\"depot\": {\"x\": 40, \"y\": 40},\"nodes\": [{\"x\": 22, \"y\": 22, \"demand\": 18},{\"x\": 36, \"y\": 26, \"demand\": 26},{\"x\": 21, \"y\": 45, \"demand\": 11},{\"x\": 45, \"y\": 35, \"demand\": 30}]}";
     DataModel model(jsonData);
-    VehicleTrip trip(&model);
+    VehicleTrip trip(model);
 
-    std::vector<int> expected = {4, 2, 1, 3};
+    ClientSequence expected = {4, 2, 1, 3};
 
     trip.addClientToTrip(1);
     trip.addClientToTrip(2);
@@ -36,7 +37,11 @@ TEST(VehicleTrip, testOptimiseTrip)
     
     trip.optimiseCost();
     ASSERT_THAT(trip.clientSeqConst(), ContainerEq(expected));
+#ifdef CVRP_ROUNDED_DISTANCES
+    EXPECT_EQ(trip.cost(), 78);
+#else
     EXPECT_NEAR(trip.cost(), 77.0276, 0.001);
+#endif
 }
 
 
@@ -45,9 +50,9 @@ TEST(VehicleTrip, testReEvaluateDemandAndCost)
     std::stringstream jsonData;
     jsonData << "{\"vehicleCapacity\": 200,\"depot\": {\"x\": 40, \"y\": 40},\"nodes\": [{\"x\": 22, \"y\": 22, \"demand\": 18},{\"x\": 36, \"y\": 26, \"demand\": 26},{\"x\": 21, \"y\": 45, \"demand\": 11},{\"x\": 45, \"y\": 35, \"demand\": 300}]}";
     DataModel model(jsonData);
-    VehicleTrip trip(&model);
+    VehicleTrip trip(model);
 
-    std::vector<int> expected = {4, 2, 1};
+    ClientSequence expected = {4, 2, 1};
 
     trip.addClientToTrip(1);
     trip.addClientToTrip(2);
@@ -58,7 +63,33 @@ TEST(VehicleTrip, testReEvaluateDemandAndCost)
     trip.reEvaluateDemandAndCost();
     EXPECT_EQ(trip.demandCovered(), 344);
     ASSERT_THAT(trip.clientSeqConst(), ContainerEq(expected));
+#ifdef CVRP_ROUNDED_DISTANCES
+    EXPECT_EQ(trip.cost(), 60);
+#else
     EXPECT_NEAR(trip.cost(), 59.8149, 0.001);
+#endif
     EXPECT_FALSE(trip.isValidTrip());
 }
 
+TEST(VehicleTrip, hashesAreKeptInStepWithEdits)
+{
+    std::stringstream json(eightClientInstanceJson);
+    DataModel model(json);
+    VehicleTrip trip(model);
+    EXPECT_EQ(trip.hash(), 0u);
+    trip.addClientToTrip(3);
+    trip.addClientToTrip(1);
+    trip.addClientToTrip(2);
+    const uint64_t appended = trip.hash();
+    trip.reEvaluateInOrder();
+    EXPECT_EQ(trip.hash(), appended);
+    EXPECT_EQ(trip.hash(), VehicleTrip::edgeKey(3, 0) ^ VehicleTrip::edgeKey(1, 3) ^ VehicleTrip::edgeKey(2, 1) ^
+            VehicleTrip::edgeKey(0, 2));
+
+    /* Reordering changes the edges and so the hash; the greedy and the in-order hashes agree */
+    trip.optimiseCost();
+    const uint64_t greedy = trip.hash();
+    trip.reEvaluateInOrder();
+    EXPECT_EQ(trip.hash(), greedy);
+    EXPECT_NE(trip.hash(), appended);
+}
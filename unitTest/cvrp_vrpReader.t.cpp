@@ -0,0 +1,67 @@
+#include "gtest/gtest.h"
+#include "../src/cvrp_vrpReader.h"
+#include "../src/cvrp_util.h"
+
+using namespace cvrp;
+
+namespace
+{
+const char *instanceVrp =
+    "NAME : tiny-n5\n"
+    "COMMENT : (depot listed second)\n"
+    "TYPE : CVRP\n"
+    "DIMENSION : 5\n"
+    "EDGE_WEIGHT_TYPE : EUC_2D\n"
+    "CAPACITY : 30\n"
+    "NODE_COORD_SECTION\n"
+    " 1 22 22\n"
+    " 2 40 40\n"
+    " 3 36 26\n"
+    " 4 21.0 45\n"
+    " 5 45 35\n"
+    "DEMAND_SECTION\n"
+    "1 18\n"
+    "2 0\n"
+    "3 26\n"
+    "4 11\n"
+    "5 30\n"
+    "DEPOT_SECTION\n"
+    " 2\n"
+    " -1\n"
+    "EOF\n";
+
+std::string replaced(const std::string& from, const std::string& to)
+{
+    std::string text(instanceVrp);
+    return text.replace(text.find(from), from.size(), to);
+}
+}
+
+TEST(VrpReader, depotBecomesIndexZero)
+{
+    ASSERT_TRUE(VrpReader::isVrp(instanceVrp));
+    ASSERT_FALSE(VrpReader::isVrp("  {\"vehicleCapacity\": 1}"));
+
+    InstanceData data = VrpReader::parse(instanceVrp, "tiny.vrp");
+    EXPECT_EQ(data.vehicleCapacity, 30);
+    ASSERT_EQ(data.xs.size(), 5u);
+    EXPECT_EQ(std::vector<int>(data.xs.begin(), data.xs.end()), std::vector<int>({40, 22, 36, 21, 45}));
+    EXPECT_EQ(std::vector<int>(data.ys.begin(), data.ys.end()), std::vector<int>({40, 22, 26, 45, 35}));
+    EXPECT_EQ(std::vector<int>(data.demands.begin(), data.demands.end()), std::vector<int>({0, 18, 26, 11, 30}));
+
+    DataModel model(VrpReader::parse(instanceVrp, "tiny.vrp"));
+    EXPECT_EQ(model.depot(), Coord(40, 40));
+    EXPECT_EQ(model.numberOfClients(), 4);
+    EXPECT_NEAR(model.distanceBetweenClients(1, 2), Util::toCost(14.5602), 0.001);
+}
+
+TEST(VrpReader, rejectsWhatTheModelCannotRepresent)
+{
+    EXPECT_THROW(VrpReader::parse(replaced(" 3 36 26", " 3 36.5 26"), "x.vrp"), std::invalid_argument);
+    EXPECT_THROW(VrpReader::parse(replaced(" 3 36 26", " 3 -36 26"), "x.vrp"), std::invalid_argument);
+    EXPECT_THROW(VrpReader::parse(replaced("EUC_2D", "GEO"), "x.vrp"), std::invalid_argument);
+    EXPECT_THROW(VrpReader::parse(replaced(" 2\n -1", " 2\n 3\n -1"), "x.vrp"), std::invalid_argument);
+    EXPECT_THROW(VrpReader::parse(replaced("2 0\n", "2 5\n"), "x.vrp"), std::invalid_argument);
+    EXPECT_THROW(VrpReader::parse(replaced(" 5 45 35\n", " 4 45 35\n"), "x.vrp"), std::invalid_argument);
+    EXPECT_THROW(VrpReader::parse(replaced("CAPACITY : 30\n", ""), "x.vrp"), std::invalid_argument);
+}